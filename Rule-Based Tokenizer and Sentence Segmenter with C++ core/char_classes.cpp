@@ -1,8 +1,8 @@
 #include "char_classes.h"
 #include <cctype>
 
-// Classifies a character by checking its type and returning the appropriate CharClass enum value
-CharClass CharClassifier::classify_char(char c){
+// Classifies a byte value by checking its type and returning the appropriate CharClass enum value
+static CharClass classify_byte(int c){
     if (std::isalpha(c)){
         return CharClass::LETTER;
     } else if (std::isdigit(c)){
@@ -22,3 +22,19 @@ CharClass CharClassifier::classify_char(char c){
     }
 }
 
+// Lookup table with the class of every byte value
+struct CharClassTable{
+    CharClassTable(){
+        for (int i = 0; i < 256; i++){
+            classes[i] = classify_byte(i);
+        }
+    }
+    CharClass classes[256];
+};
+
+// Classifies a character with a single table lookup. The table is a function-local static, built on first
+// use (thread-safe since C++11), so a Tokenizer used from another file's static initializer still sees it filled
+CharClass CharClassifier::classify_char(char c){
+    static const CharClassTable char_class_table;
+    return char_class_table.classes[static_cast<unsigned char>(c)];
+}
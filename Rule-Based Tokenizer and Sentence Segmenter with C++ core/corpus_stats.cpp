@@ -0,0 +1,210 @@
+#include "corpus_stats.h"
+#include "tokenizer.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Orders (key, count) pairs by descending count, then ascending key
+template <typename Key>
+bool by_count(const std::pair<Key, long long>& a, const std::pair<Key, long long>& b){
+    if (a.second != b.second){
+        return a.second > b.second;
+    }
+    return a.first < b.first;
+}
+
+// Initializes empty totals and resolves the thread count
+CorpusStats::CorpusStats(int num_threads, bool count_bigrams){
+    int cores = std::thread::hardware_concurrency();
+    if (cores <= 0){
+        cores = 1;
+    }
+    if (num_threads <= 0){
+        num_threads = cores;
+    }
+    // count() starts one thread per chunk; far more threads than cores gains nothing and may fail to start
+    num_threads_ = std::min(num_threads, MAX_THREADS_PER_CORE * cores);
+    count_bigrams_ = count_bigrams;
+    for (int i = 0; i < TOKEN_TYPE_COUNT; i++){
+        types_[i] = 0;
+    }
+    sentences_ = 0;
+    carry_length_ = 0;
+}
+
+// Splits the input into one chunk per thread, counts each on its own thread and merges in input order
+void CorpusStats::count(const std::string& input){
+    // Chunks end just after whitespace, so their tokens match a single pass over the whole input
+    std::vector<std::size_t> points = Tokenizer::split_points(input, (input.size() + num_threads_ - 1) / num_threads_);
+    std::vector<ChunkCounts> chunks(points.size() - 1);
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i + 1 < points.size(); i++){
+        workers.push_back(std::thread(&CorpusStats::count_chunk, this, std::cref(input),
+                                      points[i], points[i + 1], std::ref(chunks[i])));
+    }
+    for (std::size_t i = 0; i < workers.size(); i++){
+        workers[i].join();
+    }
+
+    for (std::size_t i = 0; i < chunks.size(); i++){
+        merge(chunks[i]);
+    }
+}
+
+// Feeds the chunk to the tokenizer a slice at a time and tallies tokens as they are emitted, so neither
+// a copy of the chunk nor its full token or sentence lists are ever held in memory
+void CorpusStats::count_chunk(const std::string& input, std::size_t begin, std::size_t end, ChunkCounts& counts){
+    const std::size_t SLICE_SIZE = 16 * 1024;
+    Tokenizer tokenizer;
+    std::vector<Token> tokens;
+
+    for (int i = 0; i < TOKEN_TYPE_COUNT; i++){
+        counts.types[i] = 0;
+    }
+    counts.last_open = false;
+    counts.current_length = 0;
+
+    for (std::size_t pos = begin; pos < end; pos += SLICE_SIZE){
+        tokens.clear();
+        tokenizer.feed(input.data() + pos, std::min(SLICE_SIZE, end - pos), tokens);
+        for (std::size_t i = 0; i < tokens.size(); i++){
+            count_token(tokens[i], counts);
+        }
+    }
+    tokens.clear();
+    tokenizer.finish(tokens);
+    for (std::size_t i = 0; i < tokens.size(); i++){
+        count_token(tokens[i], counts);
+    }
+
+    // A sentence still open at the end of the chunk may continue in the next one
+    if (counts.current_length > 0){
+        counts.sentence_lengths.push_back(counts.current_length);
+        counts.last_open = true;
+    }
+}
+
+// Updates the frequency maps, the bigram with the previous token of the same sentence, and sentence lengths
+void CorpusStats::count_token(const Token& t, ChunkCounts& counts){
+    counts.tokens[t.text]++;
+    counts.types[static_cast<int>(t.type)]++;
+
+    // First token of the chunk: it continues any sentence carried over from the previous chunk
+    if (counts.sentence_lengths.empty() && counts.current_length == 0){
+        counts.first_token = t.text;
+    }
+    if (count_bigrams_ && counts.current_length > 0){
+        counts.bigrams[counts.last_token + " " + t.text]++;
+    }
+    counts.last_token = t.text;
+    counts.current_length++;
+
+    // Same boundary rule as SentenceSegmenter::is_sentence_end
+    if (is_sentence_terminator(t.type, t.text)){
+        counts.sentence_lengths.push_back(counts.current_length);
+        counts.current_length = 0;
+    }
+}
+
+// Folds one chunk into the totals; an open sentence at the end of a chunk is carried into the next one
+void CorpusStats::merge(ChunkCounts& counts){
+    for (auto it = counts.tokens.begin(); it != counts.tokens.end(); ++it){
+        tokens_[it->first] += it->second;
+    }
+    for (auto it = counts.bigrams.begin(); it != counts.bigrams.end(); ++it){
+        bigrams_[it->first] += it->second;
+    }
+    for (int i = 0; i < TOKEN_TYPE_COUNT; i++){
+        types_[i] += counts.types[i];
+    }
+
+    if (counts.sentence_lengths.empty()){
+        return;
+    }
+
+    // The first sentence of this chunk continues the carried one
+    if (carry_length_ > 0){
+        counts.sentence_lengths[0] += carry_length_;
+        if (count_bigrams_){
+            bigrams_[carry_token_ + " " + counts.first_token]++;
+        }
+        carry_length_ = 0;
+    }
+
+    std::size_t complete = counts.sentence_lengths.size();
+    if (counts.last_open){
+        complete--;
+        carry_length_ = counts.sentence_lengths.back();
+        carry_token_ = counts.last_token;
+    }
+
+    for (std::size_t i = 0; i < complete; i++){
+        sentence_lengths_[counts.sentence_lengths[i]]++;
+        sentences_++;
+    }
+}
+
+// Writes totals, per-type counts, the sentence length histogram, token and bigram frequencies
+void CorpusStats::write_tsv(std::ostream& out){
+    // A trailing unterminated sentence still counts once all input has been seen
+    std::unordered_map<long long, long long> lengths = sentence_lengths_;
+    long long sentences = sentences_;
+    if (carry_length_ > 0){
+        lengths[carry_length_]++;
+        sentences++;
+    }
+
+    long long total_tokens = 0;
+    for (int i = 0; i < TOKEN_TYPE_COUNT; i++){
+        total_tokens += types_[i];
+    }
+
+    out << "total\ttokens\t" << total_tokens << "\n";
+    out << "total\ttypes\t" << tokens_.size() << "\n";
+    out << "total\tsentences\t" << sentences << "\n";
+
+    write_type_rows(out, types_);
+
+    // Histogram is ordered by sentence length rather than frequency
+    std::vector<std::pair<long long, long long>> histogram(lengths.begin(), lengths.end());
+    std::sort(histogram.begin(), histogram.end());
+    for (std::size_t i = 0; i < histogram.size(); i++){
+        out << "sentence_length\t" << histogram[i].first << "\t" << histogram[i].second << "\n";
+    }
+
+    std::vector<std::pair<std::string, long long>> token_counts(tokens_.begin(), tokens_.end());
+    std::sort(token_counts.begin(), token_counts.end(), by_count<std::string>);
+    for (std::size_t i = 0; i < token_counts.size(); i++){
+        out << "token\t" << token_counts[i].first << "\t" << token_counts[i].second << "\n";
+    }
+
+    if (count_bigrams_){
+        std::vector<std::pair<std::string, long long>> bigram_counts(bigrams_.begin(), bigrams_.end());
+        std::sort(bigram_counts.begin(), bigram_counts.end(), by_count<std::string>);
+        for (std::size_t i = 0; i < bigram_counts.size(); i++){
+            out << "bigram\t" << bigram_counts[i].first << "\t" << bigram_counts[i].second << "\n";
+        }
+    }
+}
+
+// Same total and token_type rows as write_tsv, minus the rows that need token texts
+void CorpusStats::write_counts_tsv(std::ostream& out, const TokenCounts& counts){
+    out << "total\ttokens\t" << counts.tokens << "\n";
+    out << "total\tsentences\t" << counts.sentences << "\n";
+    write_type_rows(out, counts.by_type);
+}
+
+// Sorts the per-type counts with by_count so both TSV writers order them the same way
+void CorpusStats::write_type_rows(std::ostream& out, const long long types[TOKEN_TYPE_COUNT]){
+    std::vector<std::pair<std::string, long long>> type_counts;
+    for (int i = 0; i < TOKEN_TYPE_COUNT; i++){
+        type_counts.push_back(std::make_pair(std::string(token_type_name(static_cast<TokenType>(i))), types[i]));
+    }
+    std::sort(type_counts.begin(), type_counts.end(), by_count<std::string>);
+    for (std::size_t i = 0; i < type_counts.size(); i++){
+        out << "token_type\t" << type_counts[i].first << "\t" << type_counts[i].second << "\n";
+    }
+}
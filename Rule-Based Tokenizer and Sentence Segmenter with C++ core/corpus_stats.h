@@ -0,0 +1,66 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "token.h"
+
+struct TokenCounts;
+
+// Collects corpus statistics (token, type, sentence length and bigram counts) by tokenizing on several threads
+class CorpusStats{
+    public:
+    // Creates an empty collector; num_threads <= 0 uses the hardware concurrency, and counts above
+    // MAX_THREADS_PER_CORE threads per core are clamped
+    CorpusStats(int num_threads, bool count_bigrams);
+
+    // Tokenizes and segments input in parallel chunks and adds the results to the running totals
+    void count(const std::string& input);
+    // Writes all statistics as sorted tab-separated lines: section, key, count
+    void write_tsv(std::ostream& out);
+    // Writes Tokenizer::count totals in the write_tsv layout; there is no "total types" row, since distinct
+    // tokens are not tracked while counting
+    static void write_counts_tsv(std::ostream& out, const TokenCounts& counts);
+
+    // Upper bound on worker threads per hardware core
+    static const int MAX_THREADS_PER_CORE = 4;
+
+    private:
+    // Counts gathered by one worker for one chunk of the input, merged on the calling thread afterwards
+    struct ChunkCounts{
+        std::unordered_map<std::string, long long> tokens;
+        std::unordered_map<std::string, long long> bigrams;
+        long long types[TOKEN_TYPE_COUNT];
+        // Lengths of the sentences in the chunk, in order; the first one may continue the previous chunk
+        std::vector<long long> sentence_lengths;
+        // True if the chunk's last sentence has no sentence-ending token and may continue in the next chunk
+        bool last_open;
+        std::string first_token;
+        std::string last_token;
+        // Tokens so far in the sentence being read; it is added to sentence_lengths when it ends
+        long long current_length;
+    };
+
+    // Tokenizes input[begin, end) and fills counts; runs on a worker thread
+    void count_chunk(const std::string& input, std::size_t begin, std::size_t end, ChunkCounts& counts);
+    // Tallies one token as soon as the tokenizer emits it
+    void count_token(const Token& t, ChunkCounts& counts);
+    // Writes one token_type row per TokenType, sorted by descending count
+    static void write_type_rows(std::ostream& out, const long long types[TOKEN_TYPE_COUNT]);
+    // Adds a worker's counts to the totals, joining sentences and bigrams that span the chunk boundary
+    void merge(ChunkCounts& counts);
+
+    int num_threads_;
+    bool count_bigrams_;
+
+    std::unordered_map<std::string, long long> tokens_;
+    std::unordered_map<std::string, long long> bigrams_;
+    long long types_[TOKEN_TYPE_COUNT];
+    // Sentence length -> number of sentences with that length
+    std::unordered_map<long long, long long> sentence_lengths_;
+    long long sentences_;
+
+    // Length and last token of an unterminated sentence carried over from the previous chunk
+    long long carry_length_;
+    std::string carry_token_;
+};
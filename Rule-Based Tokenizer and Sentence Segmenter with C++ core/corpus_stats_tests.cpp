@@ -0,0 +1,121 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+
+#include "corpus_stats.h"
+#include "tokenizer.h"
+
+int tests_run = 0;
+int tests_failed = 0;
+
+// Compares two strings and reports test pass/fail status
+void assert_equal(std::string got, std::string expected, std::string test_name){
+    tests_run++;
+    if (got != expected){
+        tests_failed++;
+        std::cout << "[FAIL] " << test_name << "\n";
+        std::cout << "Expected: " << expected << "\n";
+        std::cout << "Got: " << got << "\n\n";
+    } else {
+        std::cout << "[PASS] " << test_name << "\n";
+    }
+}
+
+// Checks that a TSV dump contains the given line
+void assert_has_line(std::string tsv, std::string line, std::string test_name){
+    tests_run++;
+    if (tsv.find(line + "\n") == std::string::npos){
+        tests_failed++;
+        std::cout << "[FAIL] " << test_name << "\n";
+        std::cout << "Missing line: " << line << "\n\n";
+    } else {
+        std::cout << "[PASS] " << test_name << "\n";
+    }
+}
+
+// Runs the collector over input and returns its TSV output
+std::string run_stats(std::string input, int threads, bool bigrams){
+    CorpusStats stats(threads, bigrams);
+    stats.count(input);
+    std::ostringstream out;
+    stats.write_tsv(out);
+    return out.str();
+}
+
+// Test totals, token types and token frequencies on a small input
+void test_basic_counts() {
+    std::string tsv = run_stats("The cat sat down. The dog ran 3 laps!", 1, false);
+
+    assert_has_line(tsv, "total\ttokens\t11", "basic counts: total tokens");
+    assert_has_line(tsv, "total\tsentences\t2", "basic counts: total sentences");
+    assert_has_line(tsv, "token_type\tNUMBER\t1", "basic counts: number type");
+    assert_has_line(tsv, "token\tThe\t2", "basic counts: repeated token");
+    assert_has_line(tsv, "sentence_length\t5\t1", "basic counts: short sentence");
+    assert_has_line(tsv, "sentence_length\t6\t1", "basic counts: long sentence");
+}
+
+// Test bigram counting stays within sentences
+void test_bigrams() {
+    std::string tsv = run_stats("We see birds. We see trees.", 1, true);
+
+    assert_has_line(tsv, "bigram\tWe see\t2", "bigrams: repeated bigram");
+    assert_equal(tsv.find("bigram\t. We") == std::string::npos ? "no" : "yes", "no",
+                 "bigrams: no bigram across sentence end");
+}
+
+// Test that splitting the input across threads gives exactly the single-threaded result
+void test_threads_match_single_thread() {
+    std::string input;
+    for (int i = 0; i < 200; i++){
+        input += "Dr. Smith doesn't like state-of-the-art models, or 42 of them\n";
+        if (i % 7 == 0){
+            input += "at all. Really? ";
+        }
+    }
+    input += "No ending here";
+
+    std::string single = run_stats(input, 1, true);
+    assert_equal(run_stats(input, 4, true), single, "threads: 4 threads match 1 thread");
+    assert_equal(run_stats(input, 13, true), single, "threads: 13 threads match 1 thread");
+    assert_equal(run_stats(input, 50000, true), single, "threads: oversized thread count is clamped");
+}
+
+// Test that count-only output has the --count total and token_type rows, in the same order, minus total types
+void test_counts_tsv_layout() {
+    std::string input = "The cat sat down. The dog ran 3 laps! Dr. Smith doesn't like state-of-the-art models";
+    std::istringstream full(run_stats(input, 1, false));
+    std::string expected;
+    std::string line;
+    while (std::getline(full, line)){
+        if ((line.compare(0, 6, "total\t") == 0 && line.compare(0, 12, "total\ttypes\t") != 0)
+            || line.compare(0, 11, "token_type\t") == 0){
+            expected += line + "\n";
+        }
+    }
+
+    Tokenizer tokenizer;
+    std::ostringstream out;
+    CorpusStats::write_counts_tsv(out, tokenizer.count(input));
+    assert_equal(out.str(), expected, "counts tsv: same rows and order as write_tsv");
+}
+
+// Runs all corpus statistics test cases
+int main(){
+    std::cout << "Running Corpus Stats Tests\n";
+    std::cout << "===============================\n\n";
+
+    test_basic_counts();
+    test_bigrams();
+    test_threads_match_single_thread();
+    test_counts_tsv_layout();
+
+    std::cout << "\n===============================\n";
+    std::cout << "Tests run: " << tests_run << "\n";
+    std::cout << "Tests failed: " << tests_failed << "\n";
+
+    if (tests_failed > 0){
+        return 1;
+    }
+    return 0;
+}
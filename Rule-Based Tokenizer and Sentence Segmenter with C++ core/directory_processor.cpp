@@ -0,0 +1,316 @@
+#include "directory_processor.h"
+#include "output_format.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+// Creates every missing directory along path, like mkdir -p
+static bool make_directories(const std::string& path){
+    for (std::size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)){
+        std::string prefix = path.substr(0, pos);
+        if (!prefix.empty() && mkdir(prefix.c_str(), 0777) != 0 && errno != EEXIST){
+            return false;
+        }
+        if (pos == std::string::npos){
+            return true;
+        }
+    }
+}
+
+// Adds a task at the owner's end
+void DirectoryProcessor::WorkDeque::push(const Task& task){
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(task);
+}
+
+// The owner takes its most recently added task, which is most likely to still be in cache
+bool DirectoryProcessor::WorkDeque::pop(Task& task){
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()){
+        return false;
+    }
+    task = tasks_.back();
+    tasks_.pop_back();
+    return true;
+}
+
+// Thieves take the oldest task from the other end
+bool DirectoryProcessor::WorkDeque::steal(Task& task){
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty()){
+        return false;
+    }
+    task = tasks_.front();
+    tasks_.pop_front();
+    return true;
+}
+
+// Resolves the thread count; workers are created per run
+DirectoryProcessor::DirectoryProcessor(int num_threads, std::size_t split_size){
+    int cores = std::thread::hardware_concurrency();
+    if (cores <= 0){
+        cores = 1;
+    }
+    if (num_threads <= 0){
+        num_threads = cores;
+    }
+    // Idle workers scan every deque, so far more workers than cores only adds contention
+    num_threads_ = std::min(num_threads, MAX_THREADS_PER_CORE * cores);
+    split_size_ = split_size > 0 ? split_size : 1;
+    out_ = nullptr;
+    next_id_ = 1;
+}
+
+// Lists the files, deals them out to the workers' deques and runs the pool until all tasks are done
+int DirectoryProcessor::run(const std::string& root, const std::string& output_dir, std::ostream& out){
+    output_dir_ = output_dir;
+    out_ = &out;
+    failures_ = 0;
+    next_id_ = 1;
+    finished_.clear();
+
+    std::vector<std::string> files;
+    list_files(root, "", files);
+    // Sorting makes document IDs independent of directory order
+    std::sort(files.begin(), files.end());
+
+    workers_.clear();
+    for (int i = 0; i < num_threads_; i++){
+        workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+
+    // Dealt out in reverse so each owner, popping from the back, works through its files in order
+    pending_ = files.size();
+    queued_ = files.size();
+    for (std::size_t i = files.size(); i-- > 0;){
+        std::shared_ptr<Document> document = std::make_shared<Document>();
+        document->id = i + 1;
+        document->relative_path = files[i];
+        document->path = root + "/" + files[i];
+        document->pieces_left = 0;
+
+        Task task;
+        task.document = document;
+        task.piece = -1;
+        workers_[i % num_threads_]->deque.push(task);
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads_; i++){
+        threads.push_back(std::thread(&DirectoryProcessor::worker_loop, this, i));
+    }
+    for (std::size_t i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
+
+    workers_.clear();
+    return failures_;
+}
+
+// Recursively collects regular files, skipping "." and ".." and not following directory symlinks
+void DirectoryProcessor::list_files(const std::string& root, const std::string& relative, std::vector<std::string>& files){
+    std::string dir_path = relative.empty() ? root : root + "/" + relative;
+    DIR* dir = opendir(dir_path.c_str());
+    if (dir == nullptr){
+        report_failure(dir_path + ": " + std::strerror(errno));
+        return;
+    }
+
+    while (struct dirent* entry = readdir(dir)){
+        std::string name = entry->d_name;
+        if (name == "." || name == ".."){
+            continue;
+        }
+
+        std::string child = relative.empty() ? name : relative + "/" + name;
+        std::string path = root + "/" + child;
+        struct stat info;
+        if (lstat(path.c_str(), &info) != 0){
+            report_failure(path + ": " + std::strerror(errno));
+        } else if (S_ISLNK(info.st_mode)){
+            // Symlinked files are read, but symlinked directories are skipped so links cannot create cycles
+            if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)){
+                files.push_back(child);
+            }
+        } else if (S_ISDIR(info.st_mode)){
+            list_files(root, child, files);
+        } else if (S_ISREG(info.st_mode)){
+            files.push_back(child);
+        }
+    }
+    closedir(dir);
+}
+
+// Keeps taking tasks until none are queued or running anywhere in the pool
+void DirectoryProcessor::worker_loop(int id){
+    Worker& worker = *workers_[id];
+    Task task;
+
+    while (true){
+        if (next_task(id, task)){
+            if (task.piece < 0){
+                run_file(worker, task.document);
+            } else {
+                run_piece(worker, task.document, task.piece);
+            }
+            task.document.reset();
+            if (--pending_ == 0){
+                notify_workers();
+            }
+            continue;
+        }
+
+        // Nothing to take: sleep until another worker queues pieces or the last task finishes
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        while (pending_ > 0 && queued_ == 0){
+            work_available_.wait(lock);
+        }
+        if (pending_ == 0){
+            return;
+        }
+    }
+}
+
+// Counters are changed before taking the lock, so a worker checking them under the lock cannot miss the wakeup
+void DirectoryProcessor::notify_workers(){
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    work_available_.notify_all();
+}
+
+// Tries the worker's own deque first, then the other workers in turn
+bool DirectoryProcessor::next_task(int id, Task& task){
+    if (workers_[id]->deque.pop(task)){
+        queued_--;
+        return true;
+    }
+    for (int i = 1; i < num_threads_; i++){
+        if (workers_[(id + i) % num_threads_]->deque.steal(task)){
+            queued_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Reads the whole file; large files are queued as pieces on this worker's deque for others to steal
+void DirectoryProcessor::run_file(Worker& worker, const std::shared_ptr<Document>& document){
+    std::ifstream file(document->path.c_str(), std::ios::in | std::ios::binary);
+    if (!file){
+        report_failure(document->path + ": cannot open file");
+        // Later documents on the merged stream must not wait for this one
+        if (output_dir_.empty()){
+            write_in_order(document->id, "");
+        }
+        return;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    document->text = contents.str();
+
+    std::vector<std::size_t> points = Tokenizer::split_points(document->text, split_size_);
+    int pieces = points.size() - 1;
+    document->piece_starts.assign(points.begin(), points.end() - 1);
+    document->piece_tokens.resize(pieces);
+    document->pieces_left = pieces;
+
+    if (pieces == 1){
+        run_piece(worker, document, 0);
+        return;
+    }
+
+    // Count the new tasks before they become visible so pending_ never drops to zero early
+    // and queued_ never goes negative when a thief takes a piece right away
+    pending_ += pieces;
+    queued_ += pieces;
+    for (int i = 0; i < pieces; i++){
+        Task task;
+        task.document = document;
+        task.piece = i;
+        worker.deque.push(task);
+    }
+    notify_workers();
+}
+
+// Tokenizes one piece, shifting positions so they are offsets into the whole file
+void DirectoryProcessor::run_piece(Worker& worker, const std::shared_ptr<Document>& document, int piece){
+    std::size_t begin = document->piece_starts[piece];
+    std::size_t end = piece + 1 < static_cast<int>(document->piece_starts.size()) ? document->piece_starts[piece + 1] : document->text.size();
+
+    worker.tokenizer.reset();
+    std::vector<Token> tokens = worker.tokenizer.tokenize(document->text.substr(begin, end - begin));
+    for (std::size_t i = 0; i < tokens.size(); i++){
+        tokens[i].start_index += begin;
+        tokens[i].end_index += begin;
+    }
+    document->piece_tokens[piece].swap(tokens);
+
+    // The worker that completes the last piece assembles the document
+    if (--document->pieces_left == 0){
+        finish_document(worker, *document);
+    }
+}
+
+// Concatenates piece tokens in order, segments them and writes the document
+void DirectoryProcessor::finish_document(Worker& worker, Document& document){
+    std::vector<Token> tokens;
+    for (std::size_t i = 0; i < document.piece_tokens.size(); i++){
+        tokens.insert(tokens.end(), document.piece_tokens[i].begin(), document.piece_tokens[i].end());
+    }
+    document.piece_tokens.clear();
+    document.text.clear();
+
+    write_document(document, worker.segmenter.segment(tokens));
+}
+
+// Writes to output_dir/<relative path>.tss, or hands the document to the merged stream
+void DirectoryProcessor::write_document(Document& document, const std::vector<std::vector<Token>>& sentences){
+    if (!output_dir_.empty()){
+        std::string out_path = output_dir_ + "/" + document.relative_path + ".tss";
+        std::size_t slash = out_path.rfind('/');
+        if (!make_directories(out_path.substr(0, slash))){
+            report_failure(out_path + ": " + std::strerror(errno));
+            return;
+        }
+        std::ofstream out_file(out_path.c_str());
+        print_sentences(out_file, sentences, 1);
+        if (!out_file){
+            report_failure(out_path + ": write failed");
+        }
+        return;
+    }
+
+    // Format outside the lock so workers only serialize on the final write
+    std::ostringstream formatted;
+    formatted << "Document " << document.id << ": " << document.relative_path << "\n";
+    print_sentences(formatted, sentences, 1);
+
+    write_in_order(document.id, formatted.str());
+}
+
+// Buffers a finished document until all documents with lower IDs are written, so the merged stream is
+// in ID order no matter which worker finishes first
+void DirectoryProcessor::write_in_order(int id, const std::string& formatted){
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    finished_[id] = formatted;
+    while (!finished_.empty() && finished_.begin()->first == next_id_){
+        *out_ << finished_.begin()->second;
+        finished_.erase(finished_.begin());
+        next_id_++;
+    }
+}
+
+// Prints the error and counts the failure; the run continues with the other files
+void DirectoryProcessor::report_failure(const std::string& message){
+    failures_++;
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    std::cerr << "tss: " << message << "\n";
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "token.h"
+#include "tokenizer.h"
+#include "sentence_segmenter.h"
+
+// Tokenizes and segments every file under a directory on a pool of worker threads.
+// Work is balanced with per-worker deques: a worker takes its newest task, and an idle worker
+// steals the oldest task of another. Files larger than split_size are cut into pieces that can
+// be stolen independently, so one huge file does not hold up the end of the run
+class DirectoryProcessor{
+    public:
+    // num_threads <= 0 uses the hardware concurrency, and counts above MAX_THREADS_PER_CORE threads per core are
+    // clamped
+    DirectoryProcessor(int num_threads, std::size_t split_size);
+
+    // Processes all regular files under root (symlinks to files are followed, symlinks to directories are not). With an empty output_dir every document is written to out
+    // in document ID order, prefixed with its ID and path; otherwise each document goes to output_dir/<relative path>.tss.
+    // Returns the number of files that could not be read or written
+    int run(const std::string& root, const std::string& output_dir, std::ostream& out);
+
+    // Upper bound on worker threads per hardware core
+    static const int MAX_THREADS_PER_CORE = 4;
+
+    private:
+    // One input file; pieces are tokenized independently and joined by whichever worker finishes last
+    struct Document{
+        int id;
+        std::string path;
+        std::string relative_path;
+        std::string text;
+        std::vector<std::size_t> piece_starts;
+        std::vector<std::vector<Token>> piece_tokens;
+        std::atomic<int> pieces_left;
+    };
+
+    // A whole file still to be read (piece < 0), or one piece of a file already in memory
+    struct Task{
+        std::shared_ptr<Document> document;
+        int piece;
+    };
+
+    // Double-ended task queue: the owner uses the back, thieves take from the front
+    class WorkDeque{
+        public:
+        void push(const Task& task);
+        bool pop(Task& task);
+        bool steal(Task& task);
+
+        private:
+        std::mutex mutex_;
+        std::deque<Task> tasks_;
+    };
+
+    // Per-thread state; each worker reuses its own tokenizer and segmenter for every task
+    struct Worker{
+        WorkDeque deque;
+        Tokenizer tokenizer;
+        SentenceSegmenter segmenter;
+    };
+
+    // Collects regular files below dir (recursively), as paths relative to root
+    void list_files(const std::string& root, const std::string& relative, std::vector<std::string>& files);
+    // Worker thread body: runs tasks until every task in the pool is done
+    void worker_loop(int id);
+    // Takes a task from the worker's own deque, or steals one from another worker
+    bool next_task(int id, Task& task);
+    // Wakes idle workers after tasks were queued or the last task finished
+    void notify_workers();
+    // Reads a file and either processes it directly or splits it into piece tasks
+    void run_file(Worker& worker, const std::shared_ptr<Document>& document);
+    // Tokenizes one piece and finishes the document if it was the last one
+    void run_piece(Worker& worker, const std::shared_ptr<Document>& document, int piece);
+    // Joins the piece tokens, segments them and writes the document
+    void finish_document(Worker& worker, Document& document);
+    // Writes a document's sentences to its own file or to the merged stream
+    void write_document(Document& document, const std::vector<std::vector<Token>>& sentences);
+    // Writes the formatted document to the merged stream once every document before it has been written
+    void write_in_order(int id, const std::string& formatted);
+    // Records a failed file
+    void report_failure(const std::string& message);
+
+    int num_threads_;
+    std::size_t split_size_;
+    std::string output_dir_;
+    std::ostream* out_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    // Tasks queued or running; workers exit when it reaches zero
+    std::atomic<long long> pending_;
+    // Tasks sitting in some deque; idle workers sleep while it is zero
+    std::atomic<long long> queued_;
+    std::mutex idle_mutex_;
+    std::condition_variable work_available_;
+    std::atomic<int> failures_;
+    std::mutex output_mutex_;
+    // Merged stream only, guarded by output_mutex_: the next document ID to write, and finished documents
+    // waiting for a lower ID
+    int next_id_;
+    std::map<int, std::string> finished_;
+};
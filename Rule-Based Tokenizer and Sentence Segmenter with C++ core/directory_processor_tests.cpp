@@ -0,0 +1,157 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "directory_processor.h"
+#include "output_format.h"
+#include "tokenizer.h"
+#include "sentence_segmenter.h"
+
+int tests_run = 0;
+int tests_failed = 0;
+
+// Compares two strings and reports test pass/fail status
+void assert_equal(std::string got, std::string expected, std::string test_name){
+    tests_run++;
+    if (got != expected){
+        tests_failed++;
+        std::cout << "[FAIL] " << test_name << "\n";
+        std::cout << "Expected: " << expected.substr(0, 200) << "\n";
+        std::cout << "Got: " << got.substr(0, 200) << "\n\n";
+    } else {
+        std::cout << "[PASS] " << test_name << "\n";
+    }
+}
+
+// Writes text to a file
+void write_file(const std::string& path, const std::string& text){
+    std::ofstream out(path.c_str());
+    out << text;
+}
+
+// Reads a whole file, or returns an empty string if it does not exist
+std::string read_file(const std::string& path){
+    std::ifstream in(path.c_str());
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+// Formats the single-threaded result for a text, as written by the directory processor
+std::string expected_output(const std::string& text){
+    Tokenizer tokenizer;
+    SentenceSegmenter segmenter;
+    std::ostringstream out;
+    print_sentences(out, segmenter.segment(tokenizer.tokenize(text)), 1);
+    return out.str();
+}
+
+// Builds a text long enough to be split into many pieces
+std::string long_text(){
+    std::string text;
+    for (int i = 0; i < 300; i++){
+        text += "Dr. Smith doesn't like state-of-the-art models, or 42 of them\n";
+        if (i % 5 == 0){
+            text += "at all. Really? ";
+        }
+    }
+    return text;
+}
+
+// Creates a fresh temporary directory with a nested layout of input files
+std::string make_corpus(){
+    char pattern[] = "/tmp/tss_dir_testXXXXXX";
+    std::string root = mkdtemp(pattern);
+    mkdir((root + "/in").c_str(), 0777);
+    mkdir((root + "/in/sub").c_str(), 0777);
+    write_file(root + "/in/a.txt", "Hello world. Bye!");
+    write_file(root + "/in/sub/b.txt", long_text());
+    write_file(root + "/in/sub/empty.txt", "");
+    // A link back up the tree must not make the files appear again
+    symlink("..", (root + "/in/sub/loop").c_str());
+    return root;
+}
+
+// Test that the merged stream labels each document with its ID and path in sorted order
+void test_merged_stream() {
+    std::string root = make_corpus();
+    DirectoryProcessor processor(1, 1024 * 1024);
+    std::ostringstream out;
+
+    int failures = processor.run(root + "/in", "", out);
+
+    std::string expected = "Document 1: a.txt\n" + expected_output("Hello world. Bye!") +
+                           "Document 2: sub/b.txt\n" + expected_output(long_text()) +
+                           "Document 3: sub/empty.txt\n";
+    assert_equal(std::to_string(failures), "0", "merged stream: no failures");
+    assert_equal(out.str(), expected, "merged stream: content");
+}
+
+// Test that the merged stream is in document order however the work is split and scheduled
+void test_merged_stream_order() {
+    std::string root = make_corpus();
+    write_file(root + "/in/c.txt", long_text());
+    DirectoryProcessor single(1, 1024 * 1024);
+    std::ostringstream expected;
+    single.run(root + "/in", "", expected);
+
+    std::string all_same = "yes";
+    for (int run = 0; run < 20; run++){
+        DirectoryProcessor processor(4, run % 2 == 0 ? 200 : 1024 * 1024);
+        std::ostringstream out;
+        processor.run(root + "/in", "", out);
+        if (out.str() != expected.str()){
+            all_same = "no (run " + std::to_string(run) + ")";
+        }
+    }
+    assert_equal(all_same, "yes", "merged stream order: same output for every split size and run");
+}
+
+// Test that splitting a large file across several workers gives the same sentences
+void test_split_pieces_match_whole_file() {
+    std::string root = make_corpus();
+    DirectoryProcessor processor(4, 200);
+    std::ostringstream out;
+
+    processor.run(root + "/in", root + "/out", out);
+
+    assert_equal(read_file(root + "/out/sub/b.txt.tss"), expected_output(long_text()), "split pieces: large file");
+    assert_equal(read_file(root + "/out/a.txt.tss"), expected_output("Hello world. Bye!"), "split pieces: small file");
+    assert_equal(out.str(), "", "split pieces: nothing on merged stream");
+}
+
+// Test that a missing directory is reported as a failure
+void test_missing_directory() {
+    DirectoryProcessor processor(2, 1024);
+    std::ostringstream out;
+
+    int failures = processor.run("/nonexistent/tss_dir_test", "", out);
+    assert_equal(std::to_string(failures), "1", "missing directory: failure counted");
+}
+
+// Runs all directory processor test cases
+int main(){
+    std::cout << "Running Directory Processor Tests\n";
+    std::cout << "===============================\n\n";
+
+    test_merged_stream();
+    test_merged_stream_order();
+    test_split_pieces_match_whole_file();
+    test_missing_directory();
+
+    std::cout << "\n===============================\n";
+    std::cout << "Tests run: " << tests_run << "\n";
+    std::cout << "Tests failed: " << tests_failed << "\n";
+
+    if (tests_failed > 0){
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// 64-bit FNV-1a offset basis and prime
+const std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+// Folds a block of bytes into a running FNV-1a hash and returns the updated hash
+inline std::uint64_t fnv1a_update(std::uint64_t hash, const char* data, std::size_t length){
+    for (std::size_t i = 0; i < length; i++){
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Computes the 64-bit FNV-1a hash of a string
+inline std::uint64_t fnv1a(const std::string& s){
+    return fnv1a_update(FNV_OFFSET_BASIS, s.data(), s.size());
+}
+
+// Scrambles a 64-bit value (splitmix64 finalizer); used to derive independent hash functions from one hash
+inline std::uint64_t mix64(std::uint64_t x){
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
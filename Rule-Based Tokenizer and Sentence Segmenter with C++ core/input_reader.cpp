@@ -0,0 +1,271 @@
+#include "input_reader.h"
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#ifdef TSS_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef TSS_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+// Initializes an empty, open queue
+BlockQueue::BlockQueue(std::size_t capacity){
+    capacity_ = capacity;
+    closed_ = false;
+}
+
+// Waits until there is room for the block or the queue is closed
+bool BlockQueue::push(std::string block){
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (blocks_.size() >= capacity_ && !closed_){
+        not_full_.wait(lock);
+    }
+    if (closed_){
+        return false;
+    }
+    blocks_.push_back(std::move(block));
+    not_empty_.notify_one();
+    return true;
+}
+
+// Waits until a block is available, or the queue is closed and empty
+bool BlockQueue::pop(std::string& block){
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (blocks_.empty() && !closed_){
+        not_empty_.wait(lock);
+    }
+    if (blocks_.empty()){
+        return false;
+    }
+    block = std::move(blocks_.front());
+    blocks_.pop_front();
+    not_full_.notify_one();
+    return true;
+}
+
+// Closes the queue; blocks already queued can still be popped
+void BlockQueue::close(){
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+    not_full_.notify_all();
+}
+
+// Initializes the reader; nothing is read until start() is called
+InputReader::InputReader(std::FILE* file, std::size_t block_size) : queue_(2){
+    file_ = file;
+    block_size_ = block_size;
+    compression_ = Compression::NONE;
+}
+
+// Closing the queue unblocks a reader thread waiting on a full queue so it can be joined
+InputReader::~InputReader(){
+    queue_.close();
+    if (thread_.joinable()){
+        thread_.join();
+    }
+}
+
+// Launches the reader thread
+void InputReader::start(){
+    thread_ = std::thread(&InputReader::run, this);
+}
+
+// Pops the next decompressed block from the queue
+bool InputReader::next_block(std::string& block){
+    return queue_.pop(block);
+}
+
+Compression InputReader::compression() const{
+    return compression_;
+}
+
+const std::string& InputReader::error() const{
+    return error_;
+}
+
+const std::string& InputReader::warning() const{
+    return warning_;
+}
+
+// Detects the format from the magic number of the first block and streams the input through the queue.
+// compression_, error_ and warning_ are written before close(), so they are visible once pop() returns false
+void InputReader::run(){
+    std::string pending;
+    fill(pending);
+
+    const unsigned char* magic = reinterpret_cast<const unsigned char*>(pending.data());
+    if (pending.size() >= 2 && magic[0] == 0x1f && magic[1] == 0x8b){
+        compression_ = Compression::GZIP;
+        read_gzip(pending);
+    } else if (pending.size() >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd){
+        compression_ = Compression::ZSTD;
+        read_zstd(pending);
+    } else {
+        read_plain(pending);
+    }
+
+    if (error_.empty() && std::ferror(file_)){
+        error_ = std::string("read error: ") + std::strerror(errno);
+    }
+    queue_.close();
+}
+
+// Reads the next raw block, replacing the contents of raw
+bool InputReader::fill(std::string& raw){
+    raw.resize(block_size_);
+    std::size_t n = std::fread(&raw[0], 1, block_size_, file_);
+    raw.resize(n);
+    return n > 0;
+}
+
+// Uncompressed input is passed through block by block
+bool InputReader::read_plain(std::string& pending){
+    while (pending.size() > 0){
+        if (!queue_.push(std::move(pending))){
+            return false;
+        }
+        pending = std::string();
+        fill(pending);
+    }
+    return true;
+}
+
+// Inflates gzip input, including files made of several concatenated gzip members
+bool InputReader::read_gzip(std::string& pending){
+#ifdef TSS_WITH_ZLIB
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+    // 15 window bits + 16 selects the gzip wrapper
+    if (inflateInit2(&zs, 15 + 16) != Z_OK){
+        error_ = "gzip: failed to initialize decompressor";
+        return false;
+    }
+
+    std::string input = std::move(pending);
+    zs.next_in = reinterpret_cast<Bytef*>(&input[0]);
+    zs.avail_in = input.size();
+    bool stream_end = false;
+    bool output_full = false;
+
+    while (true){
+        // Only read more input once the decompressor has flushed everything it can
+        if (zs.avail_in == 0 && !output_full){
+            if (!fill(input)){
+                break;
+            }
+            zs.next_in = reinterpret_cast<Bytef*>(&input[0]);
+            zs.avail_in = input.size();
+        }
+        if (stream_end){
+            // The magic number of the next member may straddle two reads
+            if (zs.avail_in < 2){
+                std::string rest(reinterpret_cast<char*>(zs.next_in), zs.avail_in);
+                std::string more;
+                fill(more);
+                input = rest + more;
+                zs.next_in = reinterpret_cast<Bytef*>(&input[0]);
+                zs.avail_in = input.size();
+            }
+            // Like gzip -d, stop at anything that is not another member, such as tar or block padding
+            if (zs.avail_in < 2 || zs.next_in[0] != 0x1f || zs.next_in[1] != 0x8b){
+                warning_ = "gzip: ignored trailing data after the last member";
+                break;
+            }
+            inflateReset(&zs);
+            stream_end = false;
+        }
+
+        std::string block(block_size_, '\0');
+        zs.next_out = reinterpret_cast<Bytef*>(&block[0]);
+        zs.avail_out = block.size();
+
+        int ret = inflate(&zs, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END){
+            stream_end = true;
+        } else if (ret != Z_OK && ret != Z_BUF_ERROR){
+            error_ = std::string("gzip: ") + (zs.msg ? zs.msg : "corrupt input");
+            inflateEnd(&zs);
+            return false;
+        }
+        output_full = zs.avail_out == 0 && !stream_end;
+
+        block.resize(block_size_ - zs.avail_out);
+        if (block.size() > 0 && !queue_.push(std::move(block))){
+            inflateEnd(&zs);
+            return false;
+        }
+    }
+
+    inflateEnd(&zs);
+    if (!stream_end){
+        error_ = "gzip: unexpected end of input";
+        return false;
+    }
+    return true;
+#else
+    (void)pending;
+    error_ = "gzip input detected, but tss was built without zlib (TSS_WITH_ZLIB)";
+    return false;
+#endif
+}
+
+// Decompresses zstd input frame by frame
+bool InputReader::read_zstd(std::string& pending){
+#ifdef TSS_WITH_ZSTD
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    if (dctx == nullptr){
+        error_ = "zstd: failed to initialize decompressor";
+        return false;
+    }
+
+    std::string input = std::move(pending);
+    ZSTD_inBuffer in = {input.data(), input.size(), 0};
+    // 0 once a frame has been completely decoded and flushed
+    std::size_t remaining = 0;
+    bool output_full = false;
+
+    while (true){
+        // Only read more input once the decompressor has flushed everything it can
+        if (in.pos == in.size && !output_full){
+            if (!fill(input)){
+                break;
+            }
+            in.src = input.data();
+            in.size = input.size();
+            in.pos = 0;
+        }
+
+        std::string block(block_size_, '\0');
+        ZSTD_outBuffer out = {&block[0], block.size(), 0};
+
+        remaining = ZSTD_decompressStream(dctx, &out, &in);
+        if (ZSTD_isError(remaining)){
+            error_ = std::string("zstd: ") + ZSTD_getErrorName(remaining);
+            ZSTD_freeDCtx(dctx);
+            return false;
+        }
+        output_full = out.pos == out.size;
+
+        block.resize(out.pos);
+        if (block.size() > 0 && !queue_.push(std::move(block))){
+            ZSTD_freeDCtx(dctx);
+            return false;
+        }
+    }
+
+    ZSTD_freeDCtx(dctx);
+    if (remaining != 0){
+        error_ = "zstd: unexpected end of input";
+        return false;
+    }
+    return true;
+#else
+    (void)pending;
+    error_ = "zstd input detected, but tss was built without libzstd (TSS_WITH_ZSTD)";
+    return false;
+#endif
+}
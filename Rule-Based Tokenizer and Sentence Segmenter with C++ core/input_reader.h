@@ -0,0 +1,77 @@
+#pragma once
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Bounded queue of text blocks handed from a producer thread to a consumer
+class BlockQueue{
+    public:
+    // Creates a queue holding at most capacity blocks; the producer waits while it is full
+    BlockQueue(std::size_t capacity);
+
+    // Adds a block, waiting for space; returns false if the queue was closed in the meantime
+    bool push(std::string block);
+    // Takes the next block, waiting for one; returns false once the queue is closed and drained
+    bool pop(std::string& block);
+    // Marks the end of the stream and wakes up any waiting producer or consumer
+    void close();
+
+    private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::string> blocks_;
+    std::size_t capacity_;
+    bool closed_;
+};
+
+// Compression formats recognized from the first bytes of the input
+enum class Compression{
+    NONE,
+    GZIP,
+    ZSTD,
+};
+
+// Reads an input file on a background thread, transparently decompressing gzip or zstd data,
+// and hands out fixed-size blocks of text so reading overlaps with tokenization
+class InputReader{
+    public:
+    // Prepares to read from file (not owned) in blocks of block_size bytes
+    InputReader(std::FILE* file, std::size_t block_size = 64 * 1024);
+    // Stops the reader thread, even if the input was not read to the end
+    ~InputReader();
+
+    // Starts the reader thread
+    void start();
+    // Waits for the next block of decompressed text; returns false at the end of input or on error
+    bool next_block(std::string& block);
+
+    // Format detected from the input, valid once next_block() has returned a block or false
+    Compression compression() const;
+    // Description of the read or decompression error, empty if the input was read successfully
+    const std::string& error() const;
+    // Description of input that was skipped without failing the read (such as padding after gzip data), or empty
+    const std::string& warning() const;
+
+    private:
+    // Reader thread body: sniffs the format and dispatches to the matching reader
+    void run();
+    // Reads up to block_size_ bytes from the file into raw, returning false at end of file
+    bool fill(std::string& raw);
+    // Copy loops for each format; pending holds input already read while sniffing the format
+    bool read_plain(std::string& pending);
+    bool read_gzip(std::string& pending);
+    bool read_zstd(std::string& pending);
+
+    std::FILE* file_;
+    std::size_t block_size_;
+    // Two blocks in flight: one being tokenized while the next is decompressed
+    BlockQueue queue_;
+    std::thread thread_;
+    Compression compression_;
+    std::string error_;
+    std::string warning_;
+};
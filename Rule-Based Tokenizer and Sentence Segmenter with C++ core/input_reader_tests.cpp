@@ -0,0 +1,200 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "input_reader.h"
+
+#ifdef TSS_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef TSS_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+int tests_run = 0;
+int tests_failed = 0;
+
+// Compares two strings and reports test pass/fail status
+void assert_equal(std::string got, std::string expected, std::string test_name){
+    tests_run++;
+    if (got != expected){
+        tests_failed++;
+        std::cout << "[FAIL] " << test_name << "\n";
+        std::cout << "Expected: " << expected.substr(0, 80) << "\n";
+        std::cout << "Got: " << got.substr(0, 80) << "\n\n";
+    } else {
+        std::cout << "[PASS] " << test_name << "\n";
+    }
+}
+
+// Writes bytes to an anonymous temporary file and rewinds it
+std::FILE* temp_file_with(const std::string& bytes){
+    std::FILE* file = std::tmpfile();
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::rewind(file);
+    return file;
+}
+
+// Reads a whole file through an InputReader with the given block size
+std::string read_all(std::FILE* file, std::size_t block_size, std::string& error){
+    InputReader reader(file, block_size);
+    reader.start();
+
+    std::string result;
+    std::string block;
+    while (reader.next_block(block)){
+        result += block;
+    }
+    error = reader.error();
+    return result;
+}
+
+// Builds a test text larger than the block sizes used below
+std::string sample_text(){
+    std::string text;
+    for (int i = 0; i < 500; i++){
+        text += "Dr. Smith doesn't like state-of-the-art models. Line " + std::to_string(i) + ".\n";
+    }
+    return text;
+}
+
+// Test that uncompressed input passes through unchanged
+void test_plain_input() {
+    std::string text = sample_text();
+    std::FILE* file = temp_file_with(text);
+    std::string error;
+
+    assert_equal(read_all(file, 100, error), text, "plain input: content");
+    assert_equal(error, "", "plain input: no error");
+    std::fclose(file);
+}
+
+// Test that empty input yields no blocks
+void test_empty_input() {
+    std::FILE* file = temp_file_with("");
+    std::string error;
+
+    assert_equal(read_all(file, 100, error), "", "empty input: content");
+    std::fclose(file);
+}
+
+#ifdef TSS_WITH_ZLIB
+// Compresses text into a single gzip member
+std::string gzip(const std::string& text){
+    z_stream zs = {};
+    deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&zs, text.size()), '\0');
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+    zs.avail_in = text.size();
+    zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    zs.avail_out = out.size();
+    deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+// Test that gzip input, including concatenated members, is decompressed
+void test_gzip_input() {
+    std::string text = sample_text();
+    std::FILE* file = temp_file_with(gzip(text) + gzip("The end."));
+    std::string error;
+
+    // Small blocks make the decompressor fill its output many times per input block
+    assert_equal(read_all(file, 64, error), text + "The end.", "gzip input: content");
+    assert_equal(error, "", "gzip input: no error");
+    std::fclose(file);
+}
+
+// Test that padding after the last gzip member is skipped with a warning, whatever the block boundaries
+void test_gzip_trailing_data() {
+    std::string text = sample_text();
+    std::string compressed = gzip(text) + gzip("The end.");
+    std::string all_read = "yes";
+    for (std::size_t block_size = 7; block_size < 80; block_size++){
+        std::FILE* file = temp_file_with(compressed + std::string(block_size * 3, '\0'));
+        InputReader reader(file, block_size);
+        reader.start();
+        std::string result;
+        std::string block;
+        while (reader.next_block(block)){
+            result += block;
+        }
+        if (result != text + "The end." || !reader.error().empty() || reader.warning().empty()){
+            all_read = "no (block size " + std::to_string(block_size) + ")";
+        }
+        std::fclose(file);
+    }
+    assert_equal(all_read, "yes", "gzip trailing data: content kept, warning instead of error");
+}
+
+// Test that truncated gzip input is reported as an error
+void test_truncated_gzip() {
+    std::string compressed = gzip(sample_text());
+    std::FILE* file = temp_file_with(compressed.substr(0, compressed.size() / 2));
+    std::string error;
+
+    read_all(file, 256, error);
+    assert_equal(error.empty() ? "no error" : "error", "error", "truncated gzip: error reported");
+    std::fclose(file);
+}
+#endif
+
+#ifdef TSS_WITH_ZSTD
+// Compresses text into a single zstd frame
+std::string zstd(const std::string& text){
+    std::string out(ZSTD_compressBound(text.size()), '\0');
+    out.resize(ZSTD_compress(&out[0], out.size(), text.data(), text.size(), 3));
+    return out;
+}
+
+// Test that zstd input, including concatenated frames, is decompressed
+void test_zstd_input() {
+    std::string text = sample_text();
+    std::FILE* file = temp_file_with(zstd(text) + zstd("The end."));
+    std::string error;
+
+    // Small blocks make the decompressor fill its output many times per input block
+    assert_equal(read_all(file, 64, error), text + "The end.", "zstd input: content");
+    assert_equal(error, "", "zstd input: no error");
+    std::fclose(file);
+}
+
+// Test that truncated zstd input is reported as an error
+void test_truncated_zstd() {
+    std::string compressed = zstd(sample_text());
+    std::FILE* file = temp_file_with(compressed.substr(0, compressed.size() / 2));
+    std::string error;
+
+    read_all(file, 256, error);
+    assert_equal(error.empty() ? "no error" : "error", "error", "truncated zstd: error reported");
+    std::fclose(file);
+}
+#endif
+
+// Runs all input reader test cases
+int main(){
+    std::cout << "Running Input Reader Tests\n";
+    std::cout << "===============================\n\n";
+
+    test_plain_input();
+    test_empty_input();
+#ifdef TSS_WITH_ZLIB
+    test_gzip_input();
+    test_gzip_trailing_data();
+    test_truncated_gzip();
+#endif
+#ifdef TSS_WITH_ZSTD
+    test_zstd_input();
+    test_truncated_zstd();
+#endif
+
+    std::cout << "\n===============================\n";
+    std::cout << "Tests run: " << tests_run << "\n";
+    std::cout << "Tests failed: " << tests_failed << "\n";
+
+    if (tests_failed > 0){
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "offset_index.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+const std::int64_t OffsetIndex::BLOCK_SIZE;
+
+// A byte starts a code point unless it is a UTF-8 continuation byte (10xxxxxx)
+static bool is_lead_byte(char c){
+    return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+}
+
+// Starts with a single line beginning at offset 0
+OffsetIndex::OffsetIndex(){
+    clear();
+}
+
+// Processes the block in runs that end on checkpoint boundaries, so the inner loop has no per-byte bookkeeping
+void OffsetIndex::observe(const char* data, std::size_t length){
+    std::size_t i = 0;
+    while (i < length){
+        std::int64_t in_block = bytes_ % BLOCK_SIZE;
+        if (in_block == 0){
+            block_codepoints_.push_back(codepoints_);
+        }
+        std::size_t run = std::min<std::size_t>(length - i, BLOCK_SIZE - in_block);
+
+        for (std::size_t j = 0; j < run; j++){
+            char c = data[i + j];
+            codepoints_ += is_lead_byte(c);
+            if (c == '\n'){
+                line_starts_.push_back(bytes_ + j + 1);
+            }
+        }
+        bytes_ += run;
+        i += run;
+    }
+}
+
+// Drops everything observed so far
+void OffsetIndex::clear(){
+    line_starts_.assign(1, 0);
+    block_codepoints_.clear();
+    bytes_ = 0;
+    codepoints_ = 0;
+}
+
+// Binary-searches the line, then derives the column from the code point offsets of the line start and the offset
+TextPosition OffsetIndex::resolve(const std::string& text, std::int64_t offset) const{
+    offset = std::max<std::int64_t>(0, std::min(offset, bytes_));
+
+    std::vector<std::int64_t>::const_iterator line =
+        std::upper_bound(line_starts_.begin(), line_starts_.end(), offset) - 1;
+
+    TextPosition position;
+    position.line = line - line_starts_.begin() + 1;
+    position.codepoint = codepoint_at(text, offset);
+    position.column = position.codepoint - codepoint_at(text, *line) + 1;
+    return position;
+}
+
+std::int64_t OffsetIndex::size() const{
+    return bytes_;
+}
+
+// Starts from the checkpoint of the block containing offset and counts lead bytes up to it
+std::int64_t OffsetIndex::codepoint_at(const std::string& text, std::int64_t offset) const{
+    std::size_t block = offset / BLOCK_SIZE;
+    if (block >= block_codepoints_.size()){
+        // Only reachable for the offset just past the end, when the input ends on a block boundary
+        return codepoints_;
+    }
+
+    std::int64_t count = block_codepoints_[block];
+    for (std::int64_t i = block * BLOCK_SIZE; i < offset; i++){
+        count += is_lead_byte(text[i]);
+    }
+    return count;
+}
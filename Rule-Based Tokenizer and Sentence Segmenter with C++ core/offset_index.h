@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Human-facing position of a byte offset: 1-based line and column (in code points) and 0-based code point offset
+struct TextPosition{
+    std::int64_t line;
+    std::int64_t column;
+    std::int64_t codepoint;
+};
+
+// Index of line starts and UTF-8 code point counts, filled in while the tokenizer scans its input,
+// that maps byte offsets (e.g. Token::start_index) to TextPosition in O(log n)
+class OffsetIndex{
+    public:
+    OffsetIndex();
+
+    // Records the next block of input; called by Tokenizer::feed for every block it processes
+    void observe(const char* data, std::size_t length);
+    // Forgets all observed input so the index can be reused for another document
+    void clear();
+
+    // Resolves a byte offset into text, which must be the exact input that was observed.
+    // Offsets past the observed input are clamped to its end
+    TextPosition resolve(const std::string& text, std::int64_t offset) const;
+    // Number of bytes observed so far
+    std::int64_t size() const;
+
+    private:
+    // Code points before a byte offset: a stored checkpoint plus a scan of less than one block
+    std::int64_t codepoint_at(const std::string& text, std::int64_t offset) const;
+
+    // Bytes per code point checkpoint; bounds the scan done by each lookup
+    static const std::int64_t BLOCK_SIZE = 256;
+
+    // Byte offset where each line starts; line_starts_[0] is always 0
+    std::vector<std::int64_t> line_starts_;
+    // Number of code points before the start of each BLOCK_SIZE-byte block
+    std::vector<std::int64_t> block_codepoints_;
+    std::int64_t bytes_;
+    std::int64_t codepoints_;
+};
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "offset_index.h"
+#include "tokenizer.h"
+#include "token.h"
+
+int tests_run = 0;
+int tests_failed = 0;
+
+// Compares two strings and reports test pass/fail status
+void assert_equal(std::string got, std::string expected, std::string test_name){
+    tests_run++;
+    if (got != expected){
+        tests_failed++;
+        std::cout << "[FAIL] " << test_name << "\n";
+        std::cout << "Expected: " << expected << "\n";
+        std::cout << "Got: " << got << "\n\n";
+    } else {
+        std::cout << "[PASS] " << test_name << "\n";
+    }
+}
+
+// Formats a position as line:column@codepoint
+std::string describe(TextPosition p){
+    return std::to_string(p.line) + ":" + std::to_string(p.column) + "@" + std::to_string(p.codepoint);
+}
+
+// Reference implementation: rescans the text from the start
+std::string rescan(const std::string& text, std::int64_t offset){
+    TextPosition p;
+    p.line = 1;
+    p.column = 1;
+    p.codepoint = 0;
+    for (std::int64_t i = 0; i < offset; i++){
+        unsigned char c = text[i];
+        if ((c & 0xC0) == 0x80){
+            continue;
+        }
+        p.codepoint++;
+        if (c == '\n'){
+            p.line++;
+            p.column = 1;
+        } else {
+            p.column++;
+        }
+    }
+    return describe(p);
+}
+
+// Test that token positions resolve to lines and columns when the index is built by the tokenizer
+void test_tokens_resolve() {
+    std::string input = "Hello world.\nSecond line here.";
+    OffsetIndex index;
+    Tokenizer tokenizer;
+    tokenizer.set_offset_index(&index);
+    std::vector<Token> tokens = tokenizer.tokenize(input);
+
+    assert_equal(describe(index.resolve(input, tokens[0].start_index)), "1:1@0", "tokens: first token");
+    assert_equal(describe(index.resolve(input, tokens[1].start_index)), "1:7@6", "tokens: second token");
+    assert_equal(describe(index.resolve(input, tokens[3].start_index)), "2:1@13", "tokens: start of second line");
+    assert_equal(describe(index.resolve(input, tokens[4].end_index)), "2:11@23", "tokens: end of word on second line");
+}
+
+// Test that reusing a tokenizer for a second document resolves positions in the second document
+void test_second_document() {
+    std::string first = "First doc.\nHas lines.\nThree of them.";
+    std::string second = "Second doc here.";
+    OffsetIndex index;
+    Tokenizer tokenizer;
+    tokenizer.set_offset_index(&index);
+
+    tokenizer.tokenize(first);
+    std::vector<Token> tokens = tokenizer.tokenize(second);
+
+    assert_equal(describe(index.resolve(second, tokens[1].start_index)), "1:8@7", "second document: token position");
+    assert_equal(std::to_string(index.size()), std::to_string(second.size()), "second document: index covers only it");
+
+    // After reset() the next stream also starts a fresh index
+    std::vector<Token> partial;
+    tokenizer.feed(first, partial);
+    tokenizer.reset();
+    tokenizer.feed(second, partial);
+    assert_equal(std::to_string(index.size()), std::to_string(second.size()), "second document: cleared after reset");
+}
+
+// Test that columns count code points, not bytes, for multi-byte UTF-8 characters
+void test_utf8_columns() {
+    // "café" has a two-byte é; "naïve" has a two-byte ï
+    std::string input = "caf\xC3\xA9 na\xC3\xAFve\nx \xE2\x82\xAC y";
+    OffsetIndex index;
+    index.observe(input.data(), input.size());
+
+    assert_equal(describe(index.resolve(input, 6)), "1:6@5", "utf8: after two-byte char");
+    assert_equal(describe(index.resolve(input, 15)), "2:3@13", "utf8: second line");
+    assert_equal(describe(index.resolve(input, 19)), "2:5@15", "utf8: after three-byte char");
+}
+
+// Test every offset of a long multi-line, multi-byte text against a full rescan, fed in odd-sized blocks
+void test_matches_rescan() {
+    std::string input;
+    for (int i = 0; i < 200; i++){
+        input += "Line " + std::to_string(i) + " caf\xC3\xA9 \xE2\x82\xAC";
+        input += (i % 3 == 0) ? "\n\n" : "\n";
+    }
+
+    OffsetIndex index;
+    for (std::size_t pos = 0; pos < input.size(); pos += 37){
+        index.observe(input.data() + pos, std::min<std::size_t>(37, input.size() - pos));
+    }
+
+    std::string mismatch;
+    for (std::int64_t offset = 0; offset <= static_cast<std::int64_t>(input.size()); offset++){
+        if (describe(index.resolve(input, offset)) != rescan(input, offset)){
+            mismatch = "offset " + std::to_string(offset) + ": " + describe(index.resolve(input, offset)) +
+                       " vs " + rescan(input, offset);
+            break;
+        }
+    }
+    assert_equal(mismatch, "", "rescan: all offsets match");
+}
+
+// Runs all offset index test cases
+int main(){
+    std::cout << "Running Offset Index Tests\n";
+    std::cout << "===============================\n\n";
+
+    test_tokens_resolve();
+    test_second_document();
+    test_utf8_columns();
+    test_matches_rescan();
+
+    std::cout << "\n===============================\n";
+    std::cout << "Tests run: " << tests_run << "\n";
+    std::cout << "Tests failed: " << tests_failed << "\n";
+
+    if (tests_failed > 0){
+        return 1;
+    }
+    return 0;
+}
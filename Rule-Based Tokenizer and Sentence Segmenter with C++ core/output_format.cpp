@@ -0,0 +1,30 @@
+#include "output_format.h"
+#include <ostream>
+#include <vector>
+
+// Prints each sentence with its tokens and their types, numbering sentences from first_number
+void print_sentences(std::ostream& out, const std::vector<std::vector<Token>>& sentences, int first_number){
+    for (int i = 0; i < sentences.size(); i++){
+        out << "Sentence " << first_number + i << ":\n";
+
+        for (int j = 0; j < sentences[i].size(); j++){
+            const Token& t = sentences[i][j];
+            out << " [" << t.text << "] ";
+
+            // Print the token type
+            if (t.type == TokenType::WORD) {
+                out << "WORD";
+            } else if (t.type == TokenType::NUMBER) {
+                out << "NUMBER";
+            } else if (t.type == TokenType::PUNCT) {
+                out << "PUNCT";
+            } else if (t.type == TokenType::SENTENCE_END) {
+                out << "SENTENCE_END";
+            }
+
+            out << "\n";
+        }
+
+        out << "\n";
+    }
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <ostream>
+#include <vector>
+#include "token.h"
+
+// Prints each sentence with its tokens and their types, numbering sentences from first_number
+void print_sentences(std::ostream& out, const std::vector<std::vector<Token>>& sentences, int first_number);
@@ -0,0 +1,159 @@
+#include "result_cache.h"
+#include "hash_utils.h"
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Initializes an empty cache with the given capacity
+ResultCache::ResultCache(std::size_t capacity){
+    capacity_ = capacity;
+    hits_ = 0;
+    misses_ = 0;
+}
+
+// Looks the input up by hash, confirms with a full text compare, and falls back to the tokenizer on a miss
+std::vector<std::vector<Token>> ResultCache::process(const std::string& input, Tokenizer& tokenizer, SentenceSegmenter& segmenter){
+    std::uint64_t hash = fnv1a(input);
+
+    // Several documents may share a hash, so compare the stored text before trusting a hit
+    auto range = index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it){
+        if (it->second->text == input){
+            hits_++;
+            // Move the entry to the front to mark it as most recently used
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return expand(entries_.front());
+        }
+    }
+
+    misses_++;
+    tokenizer.reset();
+    std::vector<std::vector<Token>> sentences = segmenter.segment(tokenizer.tokenize(input));
+    insert(hash, input, sentences);
+    return sentences;
+}
+
+// Runs every document through the cache, preserving input order
+std::vector<std::vector<std::vector<Token>>> ResultCache::process_batch(const std::vector<std::string>& inputs,
+                                                                        Tokenizer& tokenizer, SentenceSegmenter& segmenter){
+    std::vector<std::vector<std::vector<Token>>> results;
+    results.reserve(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); i++){
+        results.push_back(process(inputs[i], tokenizer, segmenter));
+    }
+    return results;
+}
+
+// Collects non-blank lines into the current document; a blank line or the end of input closes it
+std::vector<std::string> ResultCache::split_documents(const std::string& input){
+    std::vector<std::string> documents;
+    std::string current;
+    std::size_t line_start = 0;
+
+    while (line_start < input.size()){
+        std::size_t line_end = input.find('\n', line_start);
+        if (line_end == std::string::npos){
+            line_end = input.size();
+        }
+        std::string line = input.substr(line_start, line_end - line_start);
+
+        if (line.find_first_not_of(" \t\r") == std::string::npos){
+            if (current.size() > 0){
+                documents.push_back(current);
+                current.clear();
+            }
+        } else {
+            current += line;
+            current.push_back('\n');
+        }
+        line_start = line_end + 1;
+    }
+
+    // The last document need not be followed by a blank line or even a newline
+    if (current.size() > 0){
+        documents.push_back(current);
+    }
+    return documents;
+}
+
+// Empties the cache and its counters
+void ResultCache::clear(){
+    entries_.clear();
+    index_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+long long ResultCache::hits() const{
+    return hits_;
+}
+
+long long ResultCache::misses() const{
+    return misses_;
+}
+
+std::size_t ResultCache::size() const{
+    return entries_.size();
+}
+
+// Recreates tokens from stored positions: every token's text is the input slice it spans
+std::vector<std::vector<Token>> ResultCache::expand(const Entry& entry){
+    std::vector<std::vector<Token>> sentences;
+    sentences.reserve(entry.sentence_ends.size());
+
+    std::size_t next = 0;
+    for (std::size_t s = 0; s < entry.sentence_ends.size(); s++){
+        std::vector<Token> sentence;
+        sentence.reserve(entry.sentence_ends[s] - next);
+        for (; next < entry.sentence_ends[s]; next++){
+            const CompactToken& ct = entry.tokens[next];
+            sentence.push_back(Token(entry.text.substr(ct.start_index, ct.end_index - ct.start_index + 1),
+                                     ct.type, ct.start_index, ct.end_index));
+        }
+        sentences.push_back(sentence);
+    }
+    return sentences;
+}
+
+// Compacts a result and stores it at the front of the LRU list
+void ResultCache::insert(std::uint64_t hash, const std::string& input, const std::vector<std::vector<Token>>& sentences){
+    if (capacity_ == 0){
+        return;
+    }
+
+    Entry entry;
+    entry.hash = hash;
+    entry.text = input;
+    for (std::size_t s = 0; s < sentences.size(); s++){
+        for (std::size_t i = 0; i < sentences[s].size(); i++){
+            const Token& t = sentences[s][i];
+            // Only positional tokens can be rebuilt from the input; skip caching anything else
+            if (input.compare(t.start_index, t.end_index - t.start_index + 1, t.text) != 0){
+                return;
+            }
+            CompactToken ct;
+            ct.start_index = t.start_index;
+            ct.end_index = t.end_index;
+            ct.type = t.type;
+            entry.tokens.push_back(ct);
+        }
+        entry.sentence_ends.push_back(static_cast<std::uint32_t>(entry.tokens.size()));
+    }
+
+    // Evict the least recently used document to stay within capacity
+    if (entries_.size() >= capacity_){
+        std::list<Entry>::iterator last = std::prev(entries_.end());
+        auto range = index_.equal_range(last->hash);
+        for (auto it = range.first; it != range.second; ++it){
+            if (it->second == last){
+                index_.erase(it);
+                break;
+            }
+        }
+        entries_.erase(last);
+    }
+
+    entries_.push_front(std::move(entry));
+    index_.insert(std::make_pair(hash, entries_.begin()));
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "token.h"
+#include "tokenizer.h"
+#include "sentence_segmenter.h"
+
+// Bounded LRU cache of tokenize + segment results, keyed by a 64-bit content hash of the input text
+class ResultCache{
+    public:
+    // Creates a cache holding at most capacity documents (0 disables caching)
+    ResultCache(std::size_t capacity);
+
+    // Tokenizes and segments input, reusing the stored result when the same text was seen before
+    std::vector<std::vector<Token>> process(const std::string& input, Tokenizer& tokenizer, SentenceSegmenter& segmenter);
+    // Batch entry point: processes each document in order and returns one sentence list per document
+    std::vector<std::vector<std::vector<Token>>> process_batch(const std::vector<std::string>& inputs,
+                                                               Tokenizer& tokenizer, SentenceSegmenter& segmenter);
+    // Splits input into documents separated by one or more blank lines
+    static std::vector<std::string> split_documents(const std::string& input);
+
+    // Drops all cached documents and resets the hit/miss counters
+    void clear();
+
+    long long hits() const;
+    long long misses() const;
+    std::size_t size() const;
+
+    private:
+    // Token stored without its text; the text is recovered from the cached input by position
+    struct CompactToken{
+        std::int64_t start_index;
+        std::int64_t end_index;
+        TokenType type;
+    };
+
+    // One cached document: its full text (for the compare on hit), tokens and sentence boundaries
+    struct Entry{
+        std::uint64_t hash;
+        std::string text;
+        std::vector<CompactToken> tokens;
+        // Number of tokens up to and including the end of each sentence
+        std::vector<std::uint32_t> sentence_ends;
+    };
+
+    // Rebuilds the full sentence vectors from a compact entry
+    std::vector<std::vector<Token>> expand(const Entry& entry);
+    // Stores a freshly computed result, evicting the least recently used document if full
+    void insert(std::uint64_t hash, const std::string& input, const std::vector<std::vector<Token>>& sentences);
+
+    std::size_t capacity_;
+    long long hits_;
+    long long misses_;
+    // Most recently used entries are kept at the front
+    std::list<Entry> entries_;
+    std::unordered_multimap<std::uint64_t, std::list<Entry>::iterator> index_;
+};
@@ -0,0 +1,164 @@
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "result_cache.h"
+#include "tokenizer.h"
+#include "sentence_segmenter.h"
+#include "token.h"
+
+int tests_run = 0;
+int tests_failed = 0;
+
+// Compares two strings and reports test pass/fail status
+void assert_equal(std::string got, std::string expected, std::string test_name){
+    tests_run++;
+    if (got != expected){
+        tests_failed++;
+        std::cout << "[FAIL] " << test_name << "\n";
+        std::cout << "Expected: " << expected << "\n";
+        std::cout << "Got: " << got << "\n\n";
+    } else {
+        std::cout << "[PASS] " << test_name << "\n";
+    }
+}
+
+// Compares two integers and reports test pass/fail status
+void assert_equal(long long got, long long expected, std::string test_name){
+    tests_run++;
+    if (got != expected){
+        tests_failed++;
+        std::cout << "[FAIL] " << test_name << "\n";
+        std::cout << "Expected: " << expected << "\n";
+        std::cout << "Got: " << got << "\n\n";
+    } else {
+        std::cout << "[PASS] " << test_name << "\n";
+    }
+}
+
+// Formats sentences with token text, type and positions so cached and fresh results can be compared exactly
+std::string describe(const std::vector<std::vector<Token>>& sentences){
+    std::string result;
+    for (size_t i = 0; i < sentences.size(); i++){
+        result += "[";
+        for (size_t j = 0; j < sentences[i].size(); j++){
+            const Token& t = sentences[i][j];
+            result += t.text + "/" + std::to_string(static_cast<int>(t.type)) + "/" +
+                      std::to_string(t.start_index) + "-" + std::to_string(t.end_index);
+            if (j + 1 < sentences[i].size()){
+                result += " ";
+            }
+        }
+        result += "]";
+    }
+    return result;
+}
+
+// A repeated document is served from the cache and matches a fresh tokenization
+void test_hit_matches_fresh_result() {
+    Tokenizer tokenizer;
+    SentenceSegmenter segmenter;
+    ResultCache cache(4);
+    std::string input = "Dr. Smith doesn't like state-of-the-art models. Does he?";
+
+    std::string first = describe(cache.process(input, tokenizer, segmenter));
+    std::string second = describe(cache.process(input, tokenizer, segmenter));
+
+    Tokenizer fresh;
+    std::string expected = describe(segmenter.segment(fresh.tokenize(input)));
+
+    assert_equal(first, expected, "hit matches fresh: miss result");
+    assert_equal(second, expected, "hit matches fresh: hit result");
+    assert_equal(cache.hits(), 1, "hit matches fresh: hit count");
+    assert_equal(cache.misses(), 1, "hit matches fresh: miss count");
+}
+
+// The least recently used document is evicted once the cache is full
+void test_lru_eviction() {
+    Tokenizer tokenizer;
+    SentenceSegmenter segmenter;
+    ResultCache cache(2);
+
+    cache.process("One.", tokenizer, segmenter);
+    cache.process("Two.", tokenizer, segmenter);
+    cache.process("One.", tokenizer, segmenter);   // hit, "Two." is now least recently used
+    cache.process("Three.", tokenizer, segmenter); // evicts "Two."
+    cache.process("One.", tokenizer, segmenter);   // hit
+    cache.process("Two.", tokenizer, segmenter);   // miss
+
+    assert_equal(static_cast<long long>(cache.size()), 2, "lru eviction: size bounded");
+    assert_equal(cache.hits(), 2, "lru eviction: hit count");
+    assert_equal(cache.misses(), 4, "lru eviction: miss count");
+}
+
+// Batch processing keeps document order and counts repeats as hits
+void test_batch() {
+    Tokenizer tokenizer;
+    SentenceSegmenter segmenter;
+    ResultCache cache(8);
+    std::vector<std::string> docs = {"Thanks, Bob.", "See you soon!", "Thanks, Bob."};
+
+    std::vector<std::vector<std::vector<Token>>> results = cache.process_batch(docs, tokenizer, segmenter);
+
+    assert_equal(static_cast<long long>(results.size()), 3, "batch: result count");
+    assert_equal(describe(results[0]), describe(results[2]), "batch: repeated document");
+    assert_equal(cache.hits(), 1, "batch: hit count");
+}
+
+// A zero capacity cache never stores anything
+void test_disabled_cache() {
+    Tokenizer tokenizer;
+    SentenceSegmenter segmenter;
+    ResultCache cache(0);
+
+    cache.process("Hello.", tokenizer, segmenter);
+    cache.process("Hello.", tokenizer, segmenter);
+
+    assert_equal(static_cast<long long>(cache.size()), 0, "disabled cache: size");
+    assert_equal(cache.hits(), 0, "disabled cache: hit count");
+}
+
+// Joins documents with pipes for comparison
+std::string join_documents(const std::vector<std::string>& documents){
+    std::string result;
+    for (size_t i = 0; i < documents.size(); i++){
+        result += documents[i];
+        if (i + 1 < documents.size()){
+            result += "|";
+        }
+    }
+    return result;
+}
+
+// Documents are split on blank lines, and the last one is kept even without a trailing newline
+void test_split_documents() {
+    assert_equal(join_documents(ResultCache::split_documents("Only doc.")), "Only doc.\n",
+                 "split documents: single document without newline");
+    assert_equal(join_documents(ResultCache::split_documents("A.\n\nB.")), "A.\n|B.\n",
+                 "split documents: last document without newline");
+    assert_equal(join_documents(ResultCache::split_documents("A.\nstill A.\n \n\nB.\n\n")), "A.\nstill A.\n|B.\n",
+                 "split documents: multi-line documents and repeated blank lines");
+    assert_equal(join_documents(ResultCache::split_documents("\n\n")), "",
+                 "split documents: blank input");
+}
+
+// Runs all result cache test cases
+int main(){
+    std::cout << "Running Result Cache Tests\n";
+    std::cout << "===============================\n\n";
+
+    test_hit_matches_fresh_result();
+    test_lru_eviction();
+    test_batch();
+    test_disabled_cache();
+    test_split_documents();
+
+    std::cout << "\n===============================\n";
+    std::cout << "Tests run: " << tests_run << "\n";
+    std::cout << "Tests failed: " << tests_failed << "\n";
+
+    if (tests_failed > 0){
+        return 1;
+    }
+    return 0;
+}
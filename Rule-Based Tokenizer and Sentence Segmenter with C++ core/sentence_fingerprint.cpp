@@ -0,0 +1,91 @@
+#include "sentence_fingerprint.h"
+#include "hash_utils.h"
+#include <cctype>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Separates tokens inside a hash so that "ab c" and "a bc" differ
+const char TOKEN_SEPARATOR = '\x1f';
+
+// Initializes an empty sentence
+FingerprintBuilder::FingerprintBuilder(int minhash_size, int shingle_size){
+    minhash_size_ = minhash_size > 0 ? minhash_size : 0;
+    shingle_size_ = shingle_size > 0 ? shingle_size : 1;
+    exact_ = FNV_OFFSET_BASIS;
+    normalized_ = FNV_OFFSET_BASIS;
+    minhash_.assign(minhash_size_, std::numeric_limits<std::uint64_t>::max());
+    has_shingle_ = false;
+}
+
+// Updates the exact hash, the normalized hash and, once a full window of tokens is available, the MinHash slots
+void FingerprintBuilder::add(const Token& t){
+    exact_ = fnv1a_update(exact_, t.text.data(), t.text.size());
+    exact_ = fnv1a_update(exact_, &TOKEN_SEPARATOR, 1);
+
+    // Normalized form keeps only lower-cased letters and digits; tokens left empty (punctuation) are skipped
+    std::uint64_t token_hash = FNV_OFFSET_BASIS;
+    bool empty = true;
+    for (std::size_t i = 0; i < t.text.size(); i++){
+        unsigned char c = t.text[i];
+        if (std::isalnum(c)){
+            char lower = std::tolower(c);
+            token_hash = fnv1a_update(token_hash, &lower, 1);
+            normalized_ = fnv1a_update(normalized_, &lower, 1);
+            empty = false;
+        }
+    }
+    if (empty){
+        return;
+    }
+    normalized_ = fnv1a_update(normalized_, &TOKEN_SEPARATOR, 1);
+
+    if (minhash_size_ == 0){
+        return;
+    }
+    window_.push_back(token_hash);
+    if (window_.size() > shingle_size_){
+        window_.pop_front();
+    }
+    if (window_.size() == shingle_size_){
+        std::uint64_t shingle = 0;
+        for (std::size_t i = 0; i < window_.size(); i++){
+            shingle = mix64(shingle ^ window_[i]);
+        }
+        add_shingle(shingle);
+    }
+}
+
+// Each MinHash slot uses its own hash function, derived by mixing the shingle hash with the slot number
+void FingerprintBuilder::add_shingle(std::uint64_t shingle){
+    has_shingle_ = true;
+    for (std::size_t i = 0; i < minhash_size_; i++){
+        std::uint64_t h = mix64(shingle + (static_cast<std::uint64_t>(i) + 1) * 0x9e3779b97f4a7c15ULL);
+        if (h < minhash_[i]){
+            minhash_[i] = h;
+        }
+    }
+}
+
+// Sentences shorter than one shingle are treated as a single shingle of all their tokens
+SentenceFingerprint FingerprintBuilder::finish(){
+    if (minhash_size_ > 0 && !has_shingle_ && window_.size() > 0){
+        std::uint64_t shingle = 0;
+        for (std::size_t i = 0; i < window_.size(); i++){
+            shingle = mix64(shingle ^ window_[i]);
+        }
+        add_shingle(shingle);
+    }
+
+    SentenceFingerprint fingerprint;
+    fingerprint.exact = exact_;
+    fingerprint.normalized = normalized_;
+    fingerprint.minhash.swap(minhash_);
+
+    exact_ = FNV_OFFSET_BASIS;
+    normalized_ = FNV_OFFSET_BASIS;
+    minhash_.assign(minhash_size_, std::numeric_limits<std::uint64_t>::max());
+    window_.clear();
+    has_shingle_ = false;
+    return fingerprint;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "token.h"
+
+// Fingerprints of one sentence, used to find duplicate and near-duplicate sentences
+struct SentenceFingerprint{
+    // Hash of the token texts in order
+    std::uint64_t exact;
+    // Hash of the tokens lower-cased with punctuation removed, so "Hello, World!" matches "hello world"
+    std::uint64_t normalized;
+    // MinHash signature over shingles of normalized tokens; empty unless enabled.
+    // The fraction of equal entries between two signatures estimates the Jaccard similarity of their shingle sets
+    std::vector<std::uint64_t> minhash;
+};
+
+// Builds a SentenceFingerprint incrementally, one token at a time, without revisiting earlier tokens
+class FingerprintBuilder{
+    public:
+    // minhash_size hash functions over shingles of shingle_size tokens (minhash_size 0 disables MinHash)
+    FingerprintBuilder(int minhash_size = 0, int shingle_size = 3);
+
+    // Folds the next token of the sentence into the fingerprints
+    void add(const Token& t);
+    // Returns the fingerprint of the tokens added since the last finish() and starts a new sentence
+    SentenceFingerprint finish();
+
+    private:
+    // Adds one shingle hash to every MinHash slot
+    void add_shingle(std::uint64_t shingle);
+
+    std::size_t minhash_size_;
+    std::size_t shingle_size_;
+
+    std::uint64_t exact_;
+    std::uint64_t normalized_;
+    std::vector<std::uint64_t> minhash_;
+    // Hashes of the last shingle_size normalized tokens
+    std::deque<std::uint64_t> window_;
+    bool has_shingle_;
+};
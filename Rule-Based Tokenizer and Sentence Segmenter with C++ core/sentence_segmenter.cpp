@@ -2,40 +2,56 @@
 #include <vector>
 #include <string>
 
+// Fingerprinting is off until enable_fingerprints() is called
+SentenceSegmenter::SentenceSegmenter(){
+    fingerprints_enabled_ = false;
+}
+
+// Turns on per-sentence fingerprints for subsequent segment() calls
+void SentenceSegmenter::enable_fingerprints(int minhash_size, int shingle_size){
+    fingerprints_enabled_ = true;
+    builder_ = FingerprintBuilder(minhash_size, shingle_size);
+}
+
+const std::vector<SentenceFingerprint>& SentenceSegmenter::fingerprints() const{
+    return fingerprints_;
+}
+
 // Groups tokens into sentences by identifying sentence-ending punctuation
 std::vector<std::vector<Token>> SentenceSegmenter::segment(std::vector<Token> tokens){
     std::vector<std::vector<Token>> sentences;
     std::vector<Token> current_sentence;
+    fingerprints_.clear();
 
     // Iterate through tokens, building sentences until a sentence end is found
     for (int i = 0; i < tokens.size(); i++){
         Token t = tokens[i];
         current_sentence.push_back(t);
+        if (fingerprints_enabled_){
+            builder_.add(t);
+        }
 
         if (is_sentence_end(t)){
             sentences.push_back(current_sentence);
             current_sentence.clear();
+            if (fingerprints_enabled_){
+                fingerprints_.push_back(builder_.finish());
+            }
         }
     }
 
     // Add any remaining tokens as the final sentence
     if (current_sentence.size() > 0){
         sentences.push_back(current_sentence);
+        if (fingerprints_enabled_){
+            fingerprints_.push_back(builder_.finish());
+        }
     }
     return sentences;
 }
 
 // Checks if a token indicates the end of a sentence (period, exclamation, question mark)
 bool SentenceSegmenter::is_sentence_end(Token t){
-    if (t.type == TokenType::SENTENCE_END){
-        return true;
-    }
-
-    if (t.type == TokenType::PUNCT){
-        if (t.text == "." || t.text == "!" || t.text == "?"){
-            return true;
-        }
-    }
-    return false;
+    return is_sentence_terminator(t.type, t.text);
 }
 
@@ -2,15 +2,27 @@
 #include <string>
 #include <vector>
 #include "token.h"
+#include "sentence_fingerprint.h"
 
 // Segments a sequence of tokens into sentences based on sentence-ending punctuation
 class SentenceSegmenter{
     public:
+    SentenceSegmenter();
+
     // Takes tokens and groups them into sentences, returning a vector of sentence vectors
     std::vector<std::vector<Token>> segment(std::vector<Token> tokens);
-
-    private:
     // Determines if a token marks the end of a sentence
     bool is_sentence_end(Token t);
+
+    // Makes segment() also compute a fingerprint per sentence as its tokens are added, with an optional
+    // MinHash signature of minhash_size hashes over shingle_size-token shingles (0 disables MinHash)
+    void enable_fingerprints(int minhash_size = 0, int shingle_size = 3);
+    // Fingerprints of the sentences returned by the last segment() call, in the same order
+    const std::vector<SentenceFingerprint>& fingerprints() const;
+
+    private:
+    bool fingerprints_enabled_;
+    FingerprintBuilder builder_;
+    std::vector<SentenceFingerprint> fingerprints_;
     std::vector<std::string> abbreviations;
 };
\ No newline at end of file
@@ -269,6 +269,83 @@ void test_abbreviation_in_sentence() {
     assert_equal(result.find("Dr. Smith"), 1, "abbreviation in sentence: Dr. kept in sentence");
 }
 
+// Counts equal entries of two MinHash signatures
+int matching_slots(const SentenceFingerprint& a, const SentenceFingerprint& b) {
+    int matches = 0;
+    for (size_t i = 0; i < a.minhash.size() && i < b.minhash.size(); i++) {
+        if (a.minhash[i] == b.minhash[i]) {
+            matches++;
+        }
+    }
+    return matches;
+}
+
+// Test exact and normalized fingerprints of repeated sentences
+void test_fingerprints() {
+    SentenceSegmenter segmenter;
+    segmenter.enable_fingerprints();
+    std::vector<Token> tokens = {
+        create_word_token("Hello", 0, 4),
+        create_punct_token(",", 5, 5),
+        create_word_token("world", 7, 11),
+        create_punct_token(".", 12, 12),
+        create_word_token("hello", 14, 18),
+        create_word_token("world", 20, 24),
+        create_punct_token("!", 25, 25),
+        create_word_token("Hello", 27, 31),
+        create_punct_token(",", 32, 32),
+        create_word_token("world", 34, 38),
+        create_punct_token(".", 39, 39),
+        create_word_token("Goodbye", 41, 47)
+    };
+
+    std::vector<std::vector<Token>> sentences = segmenter.segment(tokens);
+    const std::vector<SentenceFingerprint>& fp = segmenter.fingerprints();
+
+    assert_equal(fp.size(), sentences.size(), "fingerprints: one per sentence");
+    if (fp.size() == 4) {
+        assert_equal(fp[0].exact == fp[2].exact, true, "fingerprints: identical sentences match exactly");
+        assert_equal(fp[0].exact == fp[1].exact, false, "fingerprints: case and punctuation change exact");
+        assert_equal(fp[0].normalized == fp[1].normalized, true, "fingerprints: normalized ignores case and punctuation");
+        assert_equal(fp[0].normalized == fp[3].normalized, false, "fingerprints: different sentences differ");
+        assert_equal(fp[0].minhash.size(), 0, "fingerprints: minhash off by default");
+    }
+}
+
+// Test that MinHash signatures of near-duplicate sentences agree far more than those of unrelated ones
+void test_minhash_near_duplicates() {
+    SentenceSegmenter segmenter;
+    segmenter.enable_fingerprints(64, 2);
+
+    std::string first = "the quick brown fox jumps over the lazy dog near the river bank today";
+    std::string second = "the quick brown fox jumps over the lazy dog near the river bank tonight";
+    std::string third = "completely different words appear in this other unrelated sentence here now";
+    std::vector<Token> tokens;
+    std::string texts[] = {first, second, third};
+    for (int s = 0; s < 3; s++) {
+        size_t start = 0;
+        while (start < texts[s].size()) {
+            size_t end = texts[s].find(' ', start);
+            if (end == std::string::npos) {
+                end = texts[s].size();
+            }
+            tokens.push_back(create_word_token(texts[s].substr(start, end - start), 0, 0));
+            start = end + 1;
+        }
+        tokens.push_back(create_punct_token(".", 0, 0));
+    }
+
+    segmenter.segment(tokens);
+    const std::vector<SentenceFingerprint>& fp = segmenter.fingerprints();
+
+    assert_equal(fp.size(), 3, "minhash: sentence count");
+    if (fp.size() == 3) {
+        assert_equal(fp[0].minhash.size(), 64, "minhash: signature size");
+        assert_equal(matching_slots(fp[0], fp[1]) > 40, true, "minhash: near duplicates agree");
+        assert_equal(matching_slots(fp[0], fp[2]) < 10, true, "minhash: unrelated sentences disagree");
+    }
+}
+
 // Runs all sentence segmenter test cases
 int main(){
     std::cout << "Running Sentence Segmenter Tests\n";
@@ -285,6 +362,8 @@ int main(){
     test_empty_tokens();
     test_single_sentence_ending_token();
     test_abbreviation_in_sentence();
+    test_fingerprints();
+    test_minhash_near_duplicates();
 
     std::cout << "\n===============================\n";
     std::cout << "Tests run: " << tests_run << "\n";
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 
 // Types of tokens that can be identified by the tokenizer
@@ -12,11 +13,14 @@ enum class TokenType{
     SENTENCE_END,
 };
 
+// Number of TokenType values, for tables indexed by token type
+const int TOKEN_TYPE_COUNT = 7;
+
 // Represents a single token with its text content, type, and position in the original input
 class Token {
     public:
     // Constructor that initializes a token with text, type, and position indices
-    Token(std::string t, TokenType ty, int start, int end){
+    Token(std::string t, TokenType ty, std::int64_t start, std::int64_t end){
         text = t;
         type = ty;
         start_index = start;
@@ -33,6 +37,29 @@ class Token {
 
     std::string text;
     TokenType type;
-    int start_index;
-    int end_index;
-};
\ No newline at end of file
+    // Byte offsets of the first and last character; 64-bit so inputs over 2 GB do not overflow
+    std::int64_t start_index;
+    std::int64_t end_index;
+};
+
+// Shared sentence boundary rule: explicit SENTENCE_END tokens and the punctuation tokens ".", "!" and "?"
+inline bool is_sentence_terminator(TokenType type, const std::string& text){
+    if (type == TokenType::SENTENCE_END){
+        return true;
+    }
+    return type == TokenType::PUNCT && (text == "." || text == "!" || text == "?");
+}
+
+// Returns the upper-case name of a token type, e.g. "WORD"
+inline const char* token_type_name(TokenType type){
+    switch (type){
+        case TokenType::WORD: return "WORD";
+        case TokenType::NUMBER: return "NUMBER";
+        case TokenType::PUNCT: return "PUNCT";
+        case TokenType::ABBREVIATION: return "ABBREVIATION";
+        case TokenType::CONTRACTION: return "CONTRACTION";
+        case TokenType::HYPHENATED: return "HYPHENATED";
+        case TokenType::SENTENCE_END: return "SENTENCE_END";
+    }
+    return "UNKNOWN";
+}
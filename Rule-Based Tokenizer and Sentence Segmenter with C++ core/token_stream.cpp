@@ -0,0 +1,76 @@
+#include "token_stream.h"
+#include <string>
+#include <vector>
+
+// Starts a stream at the beginning of input
+TokenStream::TokenStream(const std::string& input){
+    input_ = &input;
+    pos_ = 0;
+    pending_pos_ = 0;
+    finished_ = false;
+}
+
+// Feeds the FSM one character at a time until it emits a token or the input runs out
+bool TokenStream::next(Token& token){
+    while (pending_pos_ == pending_.size()){
+        if (finished_){
+            return false;
+        }
+        pending_.clear();
+        pending_pos_ = 0;
+
+        if (pos_ < input_->size()){
+            tokenizer_.feed(input_->data() + pos_, 1, pending_);
+            pos_++;
+        } else {
+            // End of input: flush the token still in the FSM buffer
+            tokenizer_.finish(pending_);
+            finished_ = true;
+        }
+    }
+
+    token = pending_[pending_pos_];
+    pending_pos_++;
+    return true;
+}
+
+std::size_t TokenStream::position() const{
+    return pos_;
+}
+
+TokenStream::iterator TokenStream::begin(){
+    return iterator(this);
+}
+
+TokenStream::iterator TokenStream::end(){
+    return iterator();
+}
+
+// Starts a stream at the beginning of input
+SentenceStream::SentenceStream(const std::string& input) : tokens_(input){
+}
+
+// Pulls tokens until one ends the sentence; a trailing unterminated sentence is returned as well
+bool SentenceStream::next(std::vector<Token>& sentence){
+    sentence.clear();
+    Token t;
+    while (tokens_.next(t)){
+        sentence.push_back(t);
+        if (segmenter_.is_sentence_end(t)){
+            return true;
+        }
+    }
+    return sentence.size() > 0;
+}
+
+std::size_t SentenceStream::position() const{
+    return tokens_.position();
+}
+
+SentenceStream::iterator SentenceStream::begin(){
+    return iterator(this);
+}
+
+SentenceStream::iterator SentenceStream::end(){
+    return iterator();
+}
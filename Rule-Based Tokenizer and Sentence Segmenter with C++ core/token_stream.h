@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "token.h"
+#include "tokenizer.h"
+#include "sentence_segmenter.h"
+
+// Lazily tokenizes a string: the FSM only advances as far as the consumer pulls tokens, so reading
+// the first few tokens of a long document costs about as much as those tokens.
+// The input string is not copied and must outlive the stream
+class TokenStream{
+    public:
+    TokenStream(const std::string& input);
+    // A temporary would be destroyed while the stream still points into it
+    TokenStream(const std::string&& input) = delete;
+
+    // Produces the next token; returns false once the input is exhausted
+    bool next(Token& token);
+    // Number of input characters the FSM has consumed so far
+    std::size_t position() const;
+
+    // Single-pass input iterator over the remaining tokens, for use with range-for
+    class iterator{
+        public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef Token value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Token* pointer;
+        typedef const Token& reference;
+
+        // End iterator
+        iterator() : stream_(nullptr) {}
+        // Iterator positioned on the next token of stream
+        explicit iterator(TokenStream* stream) : stream_(stream) { ++*this; }
+
+        const Token& operator*() const { return current_; }
+        const Token* operator->() const { return &current_; }
+        iterator& operator++(){
+            if (!stream_->next(current_)){
+                stream_ = nullptr;
+            }
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return stream_ == other.stream_; }
+        bool operator!=(const iterator& other) const { return stream_ != other.stream_; }
+
+        private:
+        TokenStream* stream_;
+        Token current_;
+    };
+
+    iterator begin();
+    iterator end();
+
+    private:
+    const std::string* input_;
+    std::size_t pos_;
+    Tokenizer tokenizer_;
+    // Tokens emitted by the FSM but not yet handed out
+    std::vector<Token> pending_;
+    std::size_t pending_pos_;
+    bool finished_;
+};
+
+// Lazily groups the tokens of a TokenStream into sentences, pulling only the tokens each sentence needs.
+// The input string is not copied and must outlive the stream
+class SentenceStream{
+    public:
+    SentenceStream(const std::string& input);
+    // A temporary would be destroyed while the stream still points into it
+    SentenceStream(const std::string&& input) = delete;
+
+    // Produces the next sentence; returns false once the input is exhausted
+    bool next(std::vector<Token>& sentence);
+    // Number of input characters the FSM has consumed so far
+    std::size_t position() const;
+
+    // Single-pass input iterator over the remaining sentences, for use with range-for
+    class iterator{
+        public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::vector<Token> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::vector<Token>* pointer;
+        typedef const std::vector<Token>& reference;
+
+        // End iterator
+        iterator() : stream_(nullptr) {}
+        // Iterator positioned on the next sentence of stream
+        explicit iterator(SentenceStream* stream) : stream_(stream) { ++*this; }
+
+        const std::vector<Token>& operator*() const { return current_; }
+        const std::vector<Token>* operator->() const { return &current_; }
+        iterator& operator++(){
+            if (!stream_->next(current_)){
+                stream_ = nullptr;
+            }
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return stream_ == other.stream_; }
+        bool operator!=(const iterator& other) const { return stream_ != other.stream_; }
+
+        private:
+        SentenceStream* stream_;
+        std::vector<Token> current_;
+    };
+
+    iterator begin();
+    iterator end();
+
+    private:
+    TokenStream tokens_;
+    SentenceSegmenter segmenter_;
+};
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <type_traits>
+#include <vector>
+#include <string>
+
+#include "token_stream.h"
+#include "tokenizer.h"
+#include "sentence_segmenter.h"
+#include "token.h"
+
+// Streams keep a pointer to their input, so building one from a temporary string must not compile
+static_assert(!std::is_constructible<TokenStream, std::string>::value, "TokenStream from a temporary");
+static_assert(!std::is_constructible<SentenceStream, std::string>::value, "SentenceStream from a temporary");
+static_assert(std::is_constructible<TokenStream, std::string&>::value, "TokenStream from an lvalue");
+
+int tests_run = 0;
+int tests_failed = 0;
+
+// Compares two strings and reports test pass/fail status
+void assert_equal(std::string got, std::string expected, std::string test_name){
+    tests_run++;
+    if (got != expected){
+        tests_failed++;
+        std::cout << "[FAIL] " << test_name << "\n";
+        std::cout << "Expected: " << expected << "\n";
+        std::cout << "Got: " << got << "\n\n";
+    } else {
+        std::cout << "[PASS] " << test_name << "\n";
+    }
+}
+
+// Formats tokens with their positions, separated by pipes
+std::string describe(const std::vector<Token>& tokens){
+    std::string result;
+    for (size_t i = 0; i < tokens.size(); i++){
+        result += tokens[i].text + "@" + std::to_string(tokens[i].start_index) + "-" + std::to_string(tokens[i].end_index);
+        if (i + 1 < tokens.size()){
+            result += "|";
+        }
+    }
+    return result;
+}
+
+// Test that iterating the whole stream gives the same tokens as tokenize()
+void test_token_stream_matches_tokenize() {
+    std::string input = "Dr. Smith doesn't like state-of-the-art models... Really?";
+    Tokenizer tokenizer;
+
+    std::vector<Token> streamed;
+    TokenStream stream(input);
+    for (const Token& t : stream){
+        streamed.push_back(t);
+    }
+
+    assert_equal(describe(streamed), describe(tokenizer.tokenize(input)), "token stream: matches tokenize");
+}
+
+// Test that stopping after the first tokens leaves the rest of the input unread
+void test_token_stream_stops_early() {
+    std::string input = "Hello world";
+    for (int i = 0; i < 1000; i++){
+        input += " and more words";
+    }
+
+    TokenStream stream(input);
+    std::vector<Token> first;
+    for (const Token& t : stream){
+        first.push_back(t);
+        if (first.size() == 2){
+            break;
+        }
+    }
+
+    assert_equal(describe(first), "Hello@0-4|world@6-10", "token stream early stop: tokens");
+    assert_equal(stream.position() < 20 ? "lazy" : "read " + std::to_string(stream.position()), "lazy",
+                 "token stream early stop: input consumed");
+}
+
+// Test that the sentence stream matches segment() on the full token list
+void test_sentence_stream_matches_segment() {
+    std::string input = "Dr. Smith arrived. Did he? Yes! No ending";
+    Tokenizer tokenizer;
+    SentenceSegmenter segmenter;
+    std::vector<std::vector<Token>> expected = segmenter.segment(tokenizer.tokenize(input));
+
+    std::string got;
+    std::string want;
+    SentenceStream stream(input);
+    for (const std::vector<Token>& sentence : stream){
+        got += "[" + describe(sentence) + "]";
+    }
+    for (size_t i = 0; i < expected.size(); i++){
+        want += "[" + describe(expected[i]) + "]";
+    }
+
+    assert_equal(got, want, "sentence stream: matches segment");
+}
+
+// Test that taking only the first sentence reads only that sentence
+void test_sentence_stream_first_sentence() {
+    std::string input = "Short preview here.";
+    for (int i = 0; i < 1000; i++){
+        input += " Another sentence follows.";
+    }
+
+    SentenceStream stream(input);
+    std::vector<Token> first;
+    stream.next(first);
+
+    assert_equal(describe(first), "Short@0-4|preview@6-12|here@14-17|.@18-18", "first sentence: tokens");
+    assert_equal(stream.position() < 30 ? "lazy" : "read " + std::to_string(stream.position()), "lazy",
+                 "first sentence: input consumed");
+}
+
+// Test that empty input yields nothing
+void test_empty_streams() {
+    std::string input = "";
+    TokenStream tokens(input);
+    SentenceStream sentences(input);
+
+    assert_equal(tokens.begin() == tokens.end() ? "empty" : "not empty", "empty", "empty input: token stream");
+    assert_equal(sentences.begin() == sentences.end() ? "empty" : "not empty", "empty", "empty input: sentence stream");
+}
+
+// Runs all token stream test cases
+int main(){
+    std::cout << "Running Token Stream Tests\n";
+    std::cout << "===============================\n\n";
+
+    test_token_stream_matches_tokenize();
+    test_token_stream_stops_early();
+    test_sentence_stream_matches_segment();
+    test_sentence_stream_first_sentence();
+    test_empty_streams();
+
+    std::cout << "\n===============================\n";
+    std::cout << "Tests run: " << tests_run << "\n";
+    std::cout << "Tests failed: " << tests_failed << "\n";
+
+    if (tests_failed > 0){
+        return 1;
+    }
+    return 0;
+}
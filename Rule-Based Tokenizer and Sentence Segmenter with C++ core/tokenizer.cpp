@@ -1,14 +1,28 @@
 #include "tokenizer.h"
 #include "char_classes.h"
 #include "token.h"
+#include <cctype>
 #include <string>
 #include <vector>
 
+// Starts all counters at zero
+TokenCounts::TokenCounts(){
+    for (int i = 0; i < TOKEN_TYPE_COUNT; i++){
+        by_type[i] = 0;
+    }
+    tokens = 0;
+    sentences = 0;
+}
+
 // Initializes the tokenizer with starting state and empty buffer
 Tokenizer::Tokenizer(){
     state_ = State::START;
     buffer_ = " ";
     token_start_ = 0;
+    consumed_ = 0;
+    index_ = nullptr;
+    counts_ = nullptr;
+    sentence_open_ = false;
 }
 
 // Resets the tokenizer to initial state, clearing the buffer
@@ -16,33 +30,120 @@ void Tokenizer::reset(){
     state_ = State::START;
     buffer_ = " ";
     token_start_ = 0;
+    consumed_ = 0;
+    sentence_open_ = false;
+}
+
+// Attaches (or with nullptr detaches) the offset index
+void Tokenizer::set_offset_index(OffsetIndex* index){
+    index_ = index;
 }
 
 // Main tokenization function: processes input character by character and returns all tokens
 std::vector<Token> Tokenizer::tokenize(std::string input){
     std::vector<Token> tokens;
+    feed(input, tokens);
+    finish(tokens);
+    return tokens;
+}
+
+// Counts a whole input as a single stream
+TokenCounts Tokenizer::count(const std::string& input){
+    TokenCounts counts;
+    count_feed(input, counts);
+    count_finish(counts);
+    return counts;
+}
+
+// Counts one block of a stream
+void Tokenizer::count_feed(const std::string& block, TokenCounts& counts){
+    count_feed(block.data(), block.length(), counts);
+}
+
+// Drives the FSM over the block with emit_token() redirected to the counters; output is never appended to
+void Tokenizer::count_feed(const char* data, std::size_t length, TokenCounts& counts){
+    std::vector<Token> unused;
+    counts_ = &counts;
+    feed(data, length, unused);
+    counts_ = nullptr;
+}
+
+// Flushes the last token into counts and closes the final sentence
+void Tokenizer::count_finish(TokenCounts& counts){
+    std::vector<Token> unused;
+    counts_ = &counts;
+    finish(unused);
+    counts_ = nullptr;
+
+    // Trailing tokens without a terminator form a final sentence, as in SentenceSegmenter::segment
+    if (sentence_open_){
+        counts.sentences++;
+    }
+    sentence_open_ = false;
+}
+
+// Processes one block of a stream; FSM state carries over so tokens may span block boundaries
+void Tokenizer::feed(const std::string& block, std::vector<Token>& output){
+    feed(block.data(), block.length(), output);
+}
+
+// Processes length characters starting at data
+void Tokenizer::feed(const char* data, std::size_t length, std::vector<Token>& output){
+    if (index_ != nullptr){
+        // A new stream restarts positions at 0, so the index must restart with it
+        if (consumed_ == 0){
+            index_->clear();
+        }
+        index_->observe(data, length);
+    }
 
     // Process each character through the finite state machine
-    for (int i=0; i<input.length(); i++){
-        process_char(input[i], i, tokens);
+    for (std::size_t i=0; i<length; i++){
+        process_char(data[i], consumed_ + i, output);
     }
+    consumed_ += length;
+}
 
-    // Emit any remaining token in the buffer after processing all characters
+// Ends the stream: emits any remaining token in the buffer after processing all characters
+void Tokenizer::finish(std::vector<Token>& output){
     if (buffer_ != " "){
         if (state_ == State::IN_ABBREVIATION){
-            emit_token(tokens, input.length() - 1, TokenType::ABBREVIATION);
+            emit_token(output, consumed_ - 1, TokenType::ABBREVIATION);
         } else if (state_ == State::IN_PUNCT){
-            emit_token(tokens, input.length() - 1, TokenType::PUNCT);
+            emit_token(output, consumed_ - 1, TokenType::PUNCT);
         } else {
-            emit_token(tokens, input.length() - 1, TokenType::WORD);
+            emit_token(output, consumed_ - 1, TokenType::WORD);
         }
-    } 
+    }
+    consumed_ = 0;
+}
 
-    return tokens;
+// Walks forward from each target position to the next whitespace character and cuts just after it
+std::vector<std::size_t> Tokenizer::split_points(const std::string& input, std::size_t piece_size){
+    std::vector<std::size_t> points;
+    points.push_back(0);
+    if (piece_size == 0){
+        piece_size = 1;
+    }
+
+    std::size_t pos = piece_size;
+    while (pos < input.size()){
+        while (pos < input.size() && !std::isspace(static_cast<unsigned char>(input[pos]))){
+            pos++;
+        }
+        if (pos + 1 >= input.size()){
+            break;
+        }
+        points.push_back(pos + 1);
+        pos = points.back() + piece_size;
+    }
+
+    points.push_back(input.size());
+    return points;
 }
 
 // Core FSM logic: processes each character based on current state and transitions appropriately
-void Tokenizer::process_char(char c, int index, std::vector<Token>& output){
+void Tokenizer::process_char(char c, std::int64_t index, std::vector<Token>& output){
         CharClassifier classifier;
         CharClass cc = classifier.classify_char(c);
 
@@ -66,25 +167,25 @@ void Tokenizer::process_char(char c, int index, std::vector<Token>& output){
         // IN_WORD state: accumulating letters into a word token
         else if (state_ == State::IN_WORD){
             if (cc == CharClass::LETTER){
-                buffer_ = buffer_ + c;
+                buffer_ += c;
             } else if (cc == CharClass::PERIOD){
                 // Check if this looks like an abbreviation (short word <= 4 chars including period)
-                std::string test_abbrev = buffer_ + c;
-                if (is_abbreviation_candidate(test_abbrev)){
-                    buffer_ = buffer_ + c;
+                buffer_ += c;
+                if (is_abbreviation_candidate(buffer_)){
                     state_ = State::IN_ABBREVIATION;
                 } else {
                     // Not an abbreviation, emit word and process period separately
+                    buffer_.erase(buffer_.length() - 1);
                     emit_token(output, index - 1, TokenType::WORD);
                     buffer_ = " ";
                     state_ = State::START;
                     process_char(c, index, output);
                 }
             } else if (cc == CharClass::APOSTROPHE){
-                buffer_ = buffer_ + c;
+                buffer_ += c;
                 state_ = State::IN_CONTRACTION;
             } else if (cc == CharClass::HYPHEN){
-                buffer_ = buffer_ + c;
+                buffer_ += c;
                 state_ = State::IN_HYPHENATED;
             } else {
                 emit_token(output, index - 1, TokenType::WORD);
@@ -97,7 +198,7 @@ void Tokenizer::process_char(char c, int index, std::vector<Token>& output){
         // IN_NUMBER state: accumulating digits into a number token
         else if (state_ == State::IN_NUMBER){
             if (cc == CharClass::DIGIT){
-                buffer_ = buffer_ + c;
+                buffer_ += c;
             } else {
                 emit_token(output, index - 1, TokenType::NUMBER);
                 buffer_ = " ";
@@ -109,7 +210,7 @@ void Tokenizer::process_char(char c, int index, std::vector<Token>& output){
         // IN_PUNCT state: accumulating punctuation characters
         else if (state_ == State::IN_PUNCT){
             if (cc == CharClass::PUNCT || cc == CharClass::PERIOD){
-                buffer_ = buffer_ + c;
+                buffer_ += c;
             } else {
                 emit_token(output, index - 1, TokenType::PUNCT);
                 buffer_ = " ";
@@ -121,7 +222,7 @@ void Tokenizer::process_char(char c, int index, std::vector<Token>& output){
         // IN_CONTRACTION state: processing apostrophe in contractions like "don't"
         else if (state_ == State::IN_CONTRACTION){
             if (cc == CharClass::LETTER){
-                buffer_ = buffer_ + c;
+                buffer_ += c;
                 state_ = State::IN_WORD;
             } else {
                 emit_token(output, index - 1, TokenType::CONTRACTION);
@@ -134,11 +235,11 @@ void Tokenizer::process_char(char c, int index, std::vector<Token>& output){
         // IN_ABBREVIATION state: handling abbreviations like "Dr." or "U.S."
         else if (state_ == State::IN_ABBREVIATION){
             if (cc == CharClass::LETTER){
-                buffer_ = buffer_ + c;
+                buffer_ += c;
                 state_ = State::IN_WORD;
             } else if (cc == CharClass::PERIOD){
                 // For abbreviations like "U.S.", allow letter-period-letter-period pattern
-                buffer_ = buffer_ + c;
+                buffer_ += c;
                 // Stay in IN_ABBREVIATION for multiple periods like "U.S."
             } else if (cc == CharClass::WHITESPACE){
                 // Whitespace after abbreviation - emit it
@@ -157,7 +258,7 @@ void Tokenizer::process_char(char c, int index, std::vector<Token>& output){
         // IN_HYPHENATED state: processing hyphenated words like "state-of-the-art"
         else if (state_ == State::IN_HYPHENATED){
             if (cc == CharClass::LETTER){
-                buffer_ = buffer_ + c;
+                buffer_ += c;
                 state_ = State::IN_WORD;
             } else {
                 emit_token(output, index - 1, TokenType::HYPHENATED);
@@ -169,9 +270,17 @@ void Tokenizer::process_char(char c, int index, std::vector<Token>& output){
     }
 
 // Creates a token from the current buffer and adds it to the output, then resets the buffer
-void Tokenizer::emit_token(std::vector<Token>& output, int end_index, TokenType type){
-        Token t(buffer_, type, token_start_, end_index);
-        output.push_back(t);
+void Tokenizer::emit_token(std::vector<Token>& output, std::int64_t end_index, TokenType type){
+        if (counts_ != nullptr){
+            counts_->by_type[static_cast<int>(type)]++;
+            counts_->tokens++;
+            sentence_open_ = !is_sentence_terminator(type, buffer_);
+            if (!sentence_open_){
+                counts_->sentences++;
+            }
+        } else {
+            output.push_back(Token(buffer_, type, token_start_, end_index));
+        }
         buffer_ = " ";
         state_ = State::START;
     }
@@ -182,7 +291,7 @@ void Tokenizer::transition_to(State next){
     }
 
 // Checks if a string is a candidate abbreviation: ends with period and is 4 characters or less
-bool Tokenizer::is_abbreviation_candidate(std::string s){
+bool Tokenizer::is_abbreviation_candidate(const std::string& s){
         if (s.length() > 0 && s[s.length() - 1] == '.' && s.length() <= 4){
             return true;
         } 
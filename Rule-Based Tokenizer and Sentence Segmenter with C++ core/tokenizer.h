@@ -3,6 +3,17 @@
 #include <vector>
 #include "token.h"
 #include "char_classes.h"
+#include "offset_index.h"
+
+// Token and sentence totals produced by Tokenizer::count
+struct TokenCounts{
+    TokenCounts();
+
+    // Tokens per TokenType, indexed by static_cast<int>(type)
+    long long by_type[TOKEN_TYPE_COUNT];
+    long long tokens;
+    long long sentences;
+};
 
 // Tokenizes text using a finite state machine to identify words, numbers, abbreviations, contractions, etc.
 class Tokenizer{
@@ -11,8 +22,32 @@ class Tokenizer{
 
     // Main entry point: converts input string into a vector of tokens
     std::vector<Token> tokenize(std::string input);
+    // Count-only entry point: runs the same FSM as tokenize() but only counts tokens per type and sentences
+    // (using the SentenceSegmenter rule), without building Token objects or sentence vectors
+    TokenCounts count(const std::string& input);
+    // Streaming count: adds the tokens of the next block to counts, carrying FSM state across blocks like feed()
+    void count_feed(const std::string& block, TokenCounts& counts);
+    void count_feed(const char* data, std::size_t length, TokenCounts& counts);
+    // Counts the last token and the unterminated final sentence, if any, then ends the stream like finish()
+    void count_finish(TokenCounts& counts);
+    // Streaming entry point: processes the next block of input, appending completed tokens to output.
+    // Token positions are offsets into the concatenation of all blocks fed since the last finish()
+    void feed(const std::string& block, std::vector<Token>& output);
+    void feed(const char* data, std::size_t length, std::vector<Token>& output);
+    // Emits any token still in the buffer at the end of the stream and rewinds positions to 0
+    void finish(std::vector<Token>& output);
     // Resets the tokenizer state to initial conditions
     void reset();
+    // Attaches an index that records line starts and code point positions of the input, so token offsets can
+    // later be resolved to line/column (nullptr detaches it). The index always describes the current stream:
+    // it is cleared when a new stream starts, i.e. on the first feed() after finish() or reset(), and keeps
+    // the previous document until then. Attach it before feeding the stream it should describe
+    void set_offset_index(OffsetIndex* index);
+
+    // Returns cut positions (starting with 0, ending with input.size()) that split input into pieces of
+    // roughly piece_size characters. Each cut falls just after whitespace, where the FSM is always back in
+    // START, so tokenizing the pieces separately gives the same tokens as tokenizing the whole input
+    static std::vector<std::size_t> split_points(const std::string& input, std::size_t piece_size);
 
     private:
     // States for the finite state machine that processes characters
@@ -29,17 +64,25 @@ class Tokenizer{
 
     State state_;
     std::string buffer_;
-    int token_start_;
+    std::int64_t token_start_;
+    // Number of characters fed since the last finish(), i.e. the position of the next block
+    std::int64_t consumed_;
+    // Optional line/code point index updated with every block fed; not owned
+    OffsetIndex* index_;
+    // Set during count_feed()/count_finish(): emitted tokens are tallied here instead of being added to the output
+    TokenCounts* counts_;
+    // True while the counted stream has tokens after the last sentence terminator
+    bool sentence_open_;
 
     // Processes a single character and updates the FSM state, emitting tokens when appropriate
-    void process_char(char c, int index, std::vector<Token>& output);
+    void process_char(char c, std::int64_t index, std::vector<Token>& output);
     // Creates and adds a token to the output vector using the current buffer contents
-    void emit_token(std::vector<Token>& output, int end_index, TokenType type);
+    void emit_token(std::vector<Token>& output, std::int64_t end_index, TokenType type);
     // Transitions the FSM to a new state
     void transition_to(State next);
 
     // Checks if a string matches the pattern of an abbreviation (short word ending with period)
-    bool is_abbreviation_candidate(std::string s);
+    bool is_abbreviation_candidate(const std::string& s);
     // Determines if an apostrophe is at a valid contraction boundary between two letters
     bool is_contraction_boundary(char prev, char curr);
     // Checks if a hyphen should be treated as internal to a word rather than a separator
@@ -84,6 +84,79 @@ void test_ellipsis() {
     assert_equal(joined, "Wait|...|what|?", "ellipsis");
 }
 
+// Tests that feeding input in small blocks gives the same tokens and positions as one tokenize() call
+void test_streaming_blocks() {
+    std::string input = "Dr. Smith doesn't like state-of-the-art models... Really?";
+    Tokenizer whole;
+    std::vector<Token> expected = whole.tokenize(input);
+
+    Tokenizer streaming;
+    std::vector<Token> tokens;
+    for (int i = 0; i < input.length(); i += 3){
+        streaming.feed(input.substr(i, 3), tokens);
+    }
+    streaming.finish(tokens);
+
+    std::string positions;
+    std::string expected_positions;
+    for (int i = 0; i < tokens.size(); i++){
+        positions += std::to_string(tokens[i].start_index) + "-" + std::to_string(tokens[i].end_index) + " ";
+    }
+    for (int i = 0; i < expected.size(); i++){
+        expected_positions += std::to_string(expected[i].start_index) + "-" + std::to_string(expected[i].end_index) + " ";
+    }
+
+    assert_equal(join_tokens(tokens), join_tokens(expected), "streaming blocks");
+    assert_equal(positions, expected_positions, "streaming block positions");
+}
+
+// Tests that count() agrees with tokenize() and counts sentences with the segmenter's rule
+void test_count_only() {
+    std::string input = "Dr. Smith doesn't like 42 state-of-the-art models. Does he? Wait... no ending";
+    Tokenizer tokenizer;
+    std::vector<Token> tokens = tokenizer.tokenize(input);
+    TokenCounts counts = tokenizer.count(input);
+
+    int by_type[TOKEN_TYPE_COUNT] = {0};
+    for (int i = 0; i < tokens.size(); i++){
+        by_type[static_cast<int>(tokens[i].type)]++;
+    }
+    std::string expected_types;
+    std::string got_types;
+    for (int i = 0; i < TOKEN_TYPE_COUNT; i++){
+        expected_types += std::to_string(by_type[i]) + " ";
+        got_types += std::to_string(counts.by_type[i]) + " ";
+    }
+
+    assert_equal(std::to_string(counts.tokens), std::to_string(tokens.size()), "count only: tokens");
+    assert_equal(got_types, expected_types, "count only: tokens per type");
+    assert_equal(std::to_string(counts.sentences), "3", "count only: sentences");
+    assert_equal(join_tokens(tokenizer.tokenize(input)), join_tokens(tokens), "count only: tokenize unaffected afterwards");
+}
+
+// Tests that counting block by block, with tokens split across blocks, matches counting the whole input
+void test_count_only_blocks() {
+    std::string input = "Dr. Smith doesn't like 42 state-of-the-art models. Does he? Wait... no ending";
+    Tokenizer tokenizer;
+    TokenCounts whole = tokenizer.count(input);
+
+    TokenCounts counts;
+    for (int i = 0; i < input.size(); i += 7){
+        tokenizer.count_feed(input.substr(i, 7), counts);
+    }
+    tokenizer.count_finish(counts);
+
+    std::string expected_types;
+    std::string got_types;
+    for (int i = 0; i < TOKEN_TYPE_COUNT; i++){
+        expected_types += std::to_string(whole.by_type[i]) + " ";
+        got_types += std::to_string(counts.by_type[i]) + " ";
+    }
+    assert_equal(std::to_string(counts.tokens), std::to_string(whole.tokens), "count only blocks: tokens");
+    assert_equal(got_types, expected_types, "count only blocks: tokens per type");
+    assert_equal(std::to_string(counts.sentences), "3", "count only blocks: sentences");
+}
+
 // Runs all test cases and reports the results
 int main(){
     test_simple_sentence();
@@ -91,6 +164,9 @@ int main(){
     test_hyphenation();
     test_abbreviations();
     test_ellipsis();
+    test_streaming_blocks();
+    test_count_only();
+    test_count_only_blocks();
 
     std::cout << "\nTests run:" << tests_run << "\n";
     std::cout << "Tests failed: " << tests_failed << "\n";
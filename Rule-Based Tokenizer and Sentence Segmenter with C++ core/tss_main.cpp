@@ -1,57 +1,254 @@
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "tokenizer.h"
 #include "sentence_segmenter.h"
+#include "result_cache.h"
+#include "corpus_stats.h"
+#include "input_reader.h"
+#include "output_format.h"
+#include "directory_processor.h"
 #include "token.h"
 
+// Removes sentences whose fingerprint is already in seen and adds the new ones; returns the number removed
+int drop_seen_sentences(std::vector<std::vector<Token>>& sentences, const std::vector<SentenceFingerprint>& fingerprints,
+                        bool normalized, std::unordered_set<std::uint64_t>& seen){
+    std::vector<std::vector<Token>> kept;
+    for (int i = 0; i < sentences.size(); i++){
+        std::uint64_t key = normalized ? fingerprints[i].normalized : fingerprints[i].exact;
+        if (seen.insert(key).second){
+            kept.push_back(sentences[i]);
+        }
+    }
+    int dropped = sentences.size() - kept.size();
+    sentences.swap(kept);
+    return dropped;
+}
+
+// Parses a count made only of decimal digits; rejects signs, suffixes, zero and values that overflow
+bool parse_positive(const char* text, std::size_t& value){
+    if (!std::isdigit(static_cast<unsigned char>(text[0]))){
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed == 0 || parsed > static_cast<std::size_t>(-1)){
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+// Prints command line usage to stderr
+void print_usage(){
+    std::cerr << "usage: tss [--dedup | --dedup-normalized]\n";
+    std::cerr << "       tss --cache <entries>\n";
+    std::cerr << "       tss --count [--threads <n>] [--bigrams]\n";
+    std::cerr << "       tss --count-only\n";
+    std::cerr << "       tss --recursive <dir> [--output-dir <dir>] [--threads <n>] [--split-size <bytes>]\n";
+    std::cerr << "  --dedup            skip sentences identical to one already printed\n";
+    std::cerr << "  --dedup-normalized skip sentences equal to one already printed, ignoring case and punctuation\n";
+    std::cerr << "  --cache <entries>  treat blank-line separated blocks as documents and reuse\n";
+    std::cerr << "                     results for repeated ones (LRU cache of <entries> documents)\n";
+    std::cerr << "  --count-only       print only token counts per type and the sentence count\n";
+    std::cerr << "  --count            print token, type, sentence length counts as sorted TSV\n";
+    std::cerr << "  --threads <n>      worker threads for --count and --recursive (default: all cores)\n";
+    std::cerr << "  --bigrams          also count bigrams within sentences in --count mode\n";
+    std::cerr << "  --recursive <dir>  process every file under <dir> instead of stdin\n";
+    std::cerr << "  --output-dir <dir> write one <file>.tss per input file instead of a merged stream\n";
+    std::cerr << "  --split-size <n>   split files larger than <n> bytes across workers (default: 1 MB)\n";
+}
+
 // Main program: reads input, tokenizes it, segments into sentences, and prints the results
-int main(){
+int main(int argc, char* argv[]){
+    bool use_cache = false;
+    std::size_t cache_entries = 0;
+    bool count_mode = false;
+    bool count_only = false;
+    bool count_bigrams = false;
+    int num_threads = 0;
+    std::string recursive_dir;
+    std::string output_dir;
+    std::size_t split_size = 1024 * 1024;
+    bool dedup = false;
+    bool dedup_normalized = false;
+
+    // Parse command line options
+    for (int i = 1; i < argc; i++){
+        std::string arg = argv[i];
+        if (arg == "--cache" && i + 1 < argc){
+            use_cache = true;
+            // A non-numeric or zero size would silently disable the cache, and a negative one would wrap around
+            if (!parse_positive(argv[++i], cache_entries)){
+                std::cerr << "tss: --cache needs a positive number of entries, got '" << argv[i] << "'\n";
+                return 1;
+            }
+        } else if (arg == "--dedup"){
+            dedup = true;
+        } else if (arg == "--dedup-normalized"){
+            dedup = true;
+            dedup_normalized = true;
+        } else if (arg == "--count-only"){
+            count_only = true;
+        } else if (arg == "--count"){
+            count_mode = true;
+        } else if (arg == "--threads" && i + 1 < argc){
+            // The processors clamp large counts to what the machine can run
+            std::size_t threads = 0;
+            if (!parse_positive(argv[++i], threads)){
+                std::cerr << "tss: --threads needs a positive number of threads, got '" << argv[i] << "'\n";
+                return 1;
+            }
+            num_threads = std::min<std::size_t>(threads, INT_MAX);
+        } else if (arg == "--bigrams"){
+            count_bigrams = true;
+        } else if (arg == "--recursive" && i + 1 < argc){
+            recursive_dir = argv[++i];
+        } else if (arg == "--output-dir" && i + 1 < argc){
+            output_dir = argv[++i];
+        } else if (arg == "--split-size" && i + 1 < argc){
+            // Tiny or garbage sizes would turn nearly every word into its own task
+            if (!parse_positive(argv[++i], split_size)){
+                std::cerr << "tss: --split-size needs a positive number of bytes, got '" << argv[i] << "'\n";
+                return 1;
+            }
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    // Reject options that the selected mode would silently ignore
+    const char* other_mode = nullptr;
+    if (!recursive_dir.empty()){
+        other_mode = "--recursive";
+    } else if (use_cache){
+        other_mode = "--cache";
+    } else if (count_mode){
+        other_mode = "--count";
+    } else if (count_only){
+        other_mode = "--count-only";
+    }
+    if (dedup && other_mode != nullptr){
+        std::cerr << "tss: " << (dedup_normalized ? "--dedup-normalized" : "--dedup") << " only works in the default mode, not with "
+                  << other_mode << "\n";
+        return 1;
+    }
+    if (count_only && count_mode){
+        std::cerr << "tss: --count-only and --count cannot be combined\n";
+        return 1;
+    }
+    if (count_bigrams && !count_mode){
+        std::cerr << "tss: --bigrams needs --count\n";
+        return 1;
+    }
+
+    // Directory mode: files are spread over worker threads instead of reading stdin
+    if (!recursive_dir.empty()){
+        DirectoryProcessor processor(num_threads, split_size);
+        int failures = processor.run(recursive_dir, output_dir, std::cout);
+        return failures > 0 ? 1 : 0;
+    }
+
+    // Read stdin on a background thread; gzip and zstd input is decompressed there as well
+    InputReader reader(stdin);
+    reader.start();
+
+    Tokenizer tokenizer;
+    SentenceSegmenter segmenter;
+    std::vector<Token> tokens;
+
+    // The default and count-only modes tokenize each block as it arrives; the other modes need the whole input
+    bool streaming = !count_mode && !use_cache && !count_only;
+    TokenCounts counts;
     std::string input;
-    char c;
+    std::string block;
+    long long bytes_read = 0;
+    while (reader.next_block(block)){
+        if (count_only){
+            tokenizer.count_feed(block, counts);
+        } else if (streaming){
+            tokenizer.feed(block, tokens);
+        } else {
+            input += block;
+        }
+        bytes_read += block.size();
+    }
 
-    // Read all input from stdin
-    while (std::cin.get(c)){
-        input.push_back(c);
+    if (!reader.error().empty()){
+        std::cerr << "tss: " << reader.error() << "\n";
+        return 1;
+    }
+    if (!reader.warning().empty()){
+        std::cerr << "tss: warning: " << reader.warning() << "\n";
     }
 
     // Use default test input if no input provided
-    if (input.size() == 0){
+    if (bytes_read == 0){
         input = "Dr. Meeden doesn't like state-of-the-art models. Does she?";
+        if (count_only){
+            tokenizer.count_feed(input, counts);
+        } else if (streaming){
+            tokenizer.feed(input, tokens);
+        }
     }
 
-    // Tokenize the input text
-    Tokenizer tokenizer;
-    std::vector<Token> tokens = tokenizer.tokenize(input);
+    // Sizing mode: only totals, without building tokens, sentences or a copy of the input
+    if (count_only){
+        tokenizer.count_finish(counts);
+        CorpusStats::write_counts_tsv(std::cout, counts);
+        return 0;
+    }
 
-    // Segment tokens into sentences
-    SentenceSegmenter segmenter;
-    std::vector<std::vector<Token>> sentences = segmenter.segment(tokens);
+    // Statistics mode: count tokens on several threads instead of printing them
+    if (count_mode){
+        CorpusStats stats(num_threads, count_bigrams);
+        stats.count(input);
+        stats.write_tsv(std::cout);
+        return 0;
+    }
 
-    // Print each sentence with its tokens and their types
-    for (int i = 0; i < sentences.size(); i++){
-        std::cout << "Sentence " << i + 1 << ":\n";
-
-        for (int j = 0; j < sentences[i].size(); j++){
-            Token t = sentences[i][j];
-            std::cout << " [" << t.text << "] ";
-
-            // Print the token type
-            if (t.type == TokenType::WORD) {
-                std::cout << "WORD";
-            } else if (t.type == TokenType::NUMBER) {
-                std::cout << "NUMBER";
-            } else if (t.type == TokenType::PUNCT) {
-                std::cout << "PUNCT";
-            } else if (t.type == TokenType::SENTENCE_END) {
-                std::cout << "SENTENCE_END";
-            }
+    // Cached mode: each document is looked up by content before being tokenized
+    if (use_cache){
+        ResultCache cache(cache_entries);
+        std::vector<std::vector<std::vector<Token>>> results =
+            cache.process_batch(ResultCache::split_documents(input), tokenizer, segmenter);
 
-            std::cout << "\n";
+        int sentence_number = 1;
+        for (int i = 0; i < results.size(); i++){
+            print_sentences(std::cout, results[i], sentence_number);
+            sentence_number += results[i].size();
         }
 
-        std::cout << "\n";
+        std::cerr << "cache hits: " << cache.hits() << ", misses: " << cache.misses() << "\n";
+        return 0;
+    }
+
+    // Flush the last token of the stream
+    tokenizer.finish(tokens);
+
+    // Segment tokens into sentences, fingerprinting each one when duplicates should be skipped
+    if (dedup){
+        segmenter.enable_fingerprints();
+    }
+    std::vector<std::vector<Token>> sentences = segmenter.segment(tokens);
+
+    if (dedup){
+        std::unordered_set<std::uint64_t> seen;
+        int dropped = drop_seen_sentences(sentences, segmenter.fingerprints(), dedup_normalized, seen);
+        std::cerr << "duplicate sentences skipped: " << dropped << "\n";
     }
+
+    // Print each sentence with its tokens and their types
+    print_sentences(std::cout, sentences, 1);
     return 0;
 }